@@ -0,0 +1,173 @@
+#pragma once
+
+#include <sycl/sycl.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Device profile cache shared by device_profiler (writer) and device_selector (reader)
+//
+// A profile is identified by device_key(), so both programs must agree on it and on the file
+// format; keeping them in one header is what guarantees that. Location of the cache, in order
+// of preference:
+//   $ACPP_DEVICE_PROFILE
+//   $XDG_CACHE_HOME/acpp-tutorial/device_profile.json
+//   $HOME/.cache/acpp-tutorial/device_profile.json
+
+struct device_profile {
+    std::string key; // name|backend|driver version, identifies the device across runs
+    std::string name;
+    std::string vendor;
+    std::string type;
+    std::string backend;
+    unsigned compute_units = 0;
+    double global_mem_gib = 0.0;
+    double local_mem_kib = 0.0;
+    double bandwidth_gbs = 0.0;
+    double local_bandwidth_gbs = 0.0;
+    double peak_gflops = 0.0;
+    double atomic_gops = 0.0;
+    double launch_latency_us = 0.0;
+    double jit_latency_ms = 0.0;
+};
+
+inline std::string backend_to_string(sycl::backend b) {
+    switch (b) {
+        case sycl::backend::omp: return "omp";
+        case sycl::backend::cuda: return "cuda";
+        case sycl::backend::hip: return "hip";
+        case sycl::backend::level_zero: return "level_zero";
+        case sycl::backend::ocl: return "ocl";
+        default: return "unknown";
+    }
+}
+
+inline std::string device_key(const sycl::device& dev) {
+    return dev.get_info<sycl::info::device::name>() + "|" + backend_to_string(dev.get_backend()) + "|" +
+           dev.get_info<sycl::info::device::driver_version>();
+}
+
+inline std::string profile_path() {
+    if (const char* p = std::getenv("ACPP_DEVICE_PROFILE")) {
+        return p;
+    }
+    std::string base;
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME")) {
+        base = xdg;
+    } else if (const char* home = std::getenv("HOME")) {
+        base = std::string{home} + "/.cache";
+    } else {
+        base = ".";
+    }
+    return base + "/acpp-tutorial/device_profile.json";
+}
+
+// JSON I/O. The file holds one flat object per device per line, which keeps the reader small.
+
+inline std::string json_string(const std::string& s) {
+    std::string r = "\"";
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') {
+            r += '\\';
+        }
+        r += ch;
+    }
+    return r + "\"";
+}
+
+inline std::string to_json(const device_profile& p) {
+    std::ostringstream os;
+    os << std::setprecision(6)
+       << "{\"key\": " << json_string(p.key) << ", \"name\": " << json_string(p.name)
+       << ", \"vendor\": " << json_string(p.vendor) << ", \"type\": " << json_string(p.type)
+       << ", \"backend\": " << json_string(p.backend) << ", \"compute_units\": " << p.compute_units
+       << ", \"global_mem_gib\": " << p.global_mem_gib << ", \"local_mem_kib\": " << p.local_mem_kib
+       << ", \"bandwidth_gbs\": " << p.bandwidth_gbs << ", \"local_bandwidth_gbs\": " << p.local_bandwidth_gbs
+       << ", \"peak_gflops\": " << p.peak_gflops << ", \"atomic_gops\": " << p.atomic_gops
+       << ", \"launch_latency_us\": " << p.launch_latency_us << ", \"jit_latency_ms\": " << p.jit_latency_ms << "}";
+    return os.str();
+}
+
+// Parses "key": value pairs of one flat object line
+inline std::map<std::string, std::string> parse_object(const std::string& line) {
+    std::map<std::string, std::string> fields;
+    size_t pos = line.find('{');
+    while (pos != std::string::npos) {
+        size_t k0 = line.find('"', pos);
+        if (k0 == std::string::npos) {
+            break;
+        }
+        size_t k1 = line.find('"', k0 + 1);
+        size_t colon = line.find(':', k1);
+        if (k1 == std::string::npos || colon == std::string::npos) {
+            break;
+        }
+        std::string key = line.substr(k0 + 1, k1 - k0 - 1);
+        size_t v = line.find_first_not_of(' ', colon + 1);
+        if (v == std::string::npos) {
+            break;
+        }
+        std::string value;
+        if (line[v] == '"') {
+            for (pos = v + 1; pos < line.size() && line[pos] != '"'; ++pos) {
+                if (line[pos] == '\\') {
+                    ++pos;
+                }
+                value += line[pos];
+            }
+            ++pos;
+        } else {
+            pos = line.find_first_of(",}", v);
+            value = line.substr(v, pos - v);
+        }
+        fields[key] = value;
+        pos = line.find(',', pos);
+    }
+    return fields;
+}
+
+inline std::vector<device_profile> read_profiles(const std::string& path) {
+    std::vector<device_profile> profiles;
+    std::ifstream in{path};
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.find("\"key\"") == std::string::npos) {
+            continue;
+        }
+        auto f = parse_object(line);
+        device_profile p;
+        p.key = f["key"];
+        p.name = f["name"];
+        p.vendor = f["vendor"];
+        p.type = f["type"];
+        p.backend = f["backend"];
+        p.compute_units = static_cast<unsigned>(std::atof(f["compute_units"].c_str()));
+        p.global_mem_gib = std::atof(f["global_mem_gib"].c_str());
+        p.local_mem_kib = std::atof(f["local_mem_kib"].c_str());
+        p.bandwidth_gbs = std::atof(f["bandwidth_gbs"].c_str());
+        p.local_bandwidth_gbs = std::atof(f["local_bandwidth_gbs"].c_str());
+        p.peak_gflops = std::atof(f["peak_gflops"].c_str());
+        p.atomic_gops = std::atof(f["atomic_gops"].c_str());
+        p.launch_latency_us = std::atof(f["launch_latency_us"].c_str());
+        p.jit_latency_ms = std::atof(f["jit_latency_ms"].c_str());
+        profiles.push_back(p);
+    }
+    return profiles;
+}
+
+inline bool write_profiles(const std::string& path, const std::vector<device_profile>& profiles) {
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path{path}.parent_path(), ec);
+    std::ofstream out{path};
+    out << "{\"version\": 1, \"devices\": [\n";
+    for (size_t i = 0; i < profiles.size(); ++i) {
+        out << "  " << to_json(profiles[i]) << (i + 1 < profiles.size() ? "," : "") << "\n";
+    }
+    out << "]}\n";
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,242 @@
+#include <sycl/sycl.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "device_profile.hpp"
+
+// Device capability profiler
+//
+// hello_devices prints what the runtime reports about each device. The reported numbers (compute
+// units, memory sizes) say little about speed, so this example measures it:
+//
+//   bandwidth        - global memory copy, GB/s
+//   local bandwidth  - reads from work-group local memory, GB/s
+//   peak GFLOP/s     - chains of independent FMAs
+//   atomics          - relaxed fetch_add throughput on 1024 counters, Gops/s
+//   launch latency   - submit + wait round trip of an empty kernel, us
+//   JIT latency      - extra time of a kernel's first launch (JIT compile or kernel cache load), ms
+//
+// The results are cached as JSON so other programs (see device_selector) can
+// read them at startup instead of measuring again. The cache is reused as long as it lists every
+// device present; pass --refresh to measure anyway. The cache format and location live in
+// device_profile.hpp, shared with device_selector.
+
+using clock_type = std::chrono::high_resolution_clock;
+
+std::string device_type_to_string(sycl::info::device_type type) {
+    switch (type) {
+        case sycl::info::device_type::cpu: return "cpu";
+        case sycl::info::device_type::gpu: return "gpu";
+        case sycl::info::device_type::accelerator: return "accelerator";
+        default: return "other";
+    }
+}
+
+// Measurements
+
+template <class F>
+double best_seconds(sycl::queue& q, int reps, F run) {
+    double best = 1e30;
+    for (int r = 0; r < reps; ++r) {
+        auto t0 = clock_type::now();
+        run();
+        q.wait();
+        best = std::min(best, std::chrono::duration<double>(clock_type::now() - t0).count());
+    }
+    return best;
+}
+
+double seconds_since(clock_type::time_point t0) {
+    return std::chrono::duration<double>(clock_type::now() - t0).count();
+}
+
+// Sets ok = false if a measurement kernel computes a wrong result
+device_profile measure(const sycl::device& dev, bool& ok) {
+    sycl::queue q{dev, sycl::property_list{sycl::property::queue::in_order{}}};
+    device_profile p;
+    p.key = device_key(dev);
+    p.name = dev.get_info<sycl::info::device::name>();
+    p.vendor = dev.get_info<sycl::info::device::vendor>();
+    p.type = device_type_to_string(dev.get_info<sycl::info::device::device_type>());
+    p.backend = backend_to_string(dev.get_backend());
+    p.compute_units = dev.get_info<sycl::info::device::max_compute_units>();
+    p.global_mem_gib = static_cast<double>(dev.get_info<sycl::info::device::global_mem_size>()) / (1 << 30);
+    p.local_mem_kib = static_cast<double>(dev.get_info<sycl::info::device::local_mem_size>()) / 1024;
+
+    // JIT latency first, while no kernel has run on this device yet
+    auto t0 = clock_type::now();
+    q.single_task<class FirstLaunchKernel>([=]() {}).wait();
+    double first_launch = seconds_since(t0);
+
+    // Launch latency: empty kernel round trips
+    const int LAUNCHES = 200;
+    auto empty_launch = [&] {
+        q.single_task<class EmptyKernel>([=]() {}).wait();
+    };
+    empty_launch();
+    t0 = clock_type::now();
+    for (int i = 0; i < LAUNCHES; ++i) {
+        empty_launch();
+    }
+    p.launch_latency_us = seconds_since(t0) / LAUNCHES * 1e6;
+    p.jit_latency_ms = std::max(0.0, first_launch * 1e3 - p.launch_latency_us / 1e3);
+
+    // Global memory bandwidth: copy, 2 * n floats moved
+    size_t n = std::min<size_t>(32 * 1024 * 1024, dev.get_info<sycl::info::device::max_mem_alloc_size>() / sizeof(float));
+    float* a = sycl::malloc_device<float>(n, q);
+    float* b = sycl::malloc_device<float>(n, q);
+    q.fill(a, 1.0f, n).wait();
+    auto copy = [&] {
+        q.parallel_for<class CopyKernel>(sycl::range<1>{n}, [=](sycl::id<1> i) {
+            b[i] = a[i];
+        });
+    };
+    copy();
+    q.wait();
+    p.bandwidth_gbs = 2.0 * n * sizeof(float) / best_seconds(q, 3, copy) / 1e9;
+    float check = 0.0f;
+    q.memcpy(&check, b + n - 1, sizeof(float)).wait();
+    ok = ok && check == 1.0f;
+
+    // Local memory bandwidth: every work-item reads ITERS floats from its group's tile
+    const size_t WG = std::min<size_t>(256, dev.get_info<sycl::info::device::max_work_group_size>());
+    const size_t LOCAL_GLOBAL = (1 << 20) / WG * WG;
+    const size_t ITERS = 256;
+    auto local_reads = [&] {
+        q.submit([&](sycl::handler& cgh) {
+            sycl::local_accessor<float, 1> tile{WG, cgh};
+            cgh.parallel_for<class LocalBandwidthKernel>(sycl::nd_range<1>{LOCAL_GLOBAL, WG}, [=](sycl::nd_item<1> item) {
+                size_t lid = item.get_local_id(0);
+                tile[lid] = static_cast<float>(lid);
+                sycl::group_barrier(item.get_group());
+                float acc = 0.0f;
+                for (size_t k = 0; k < ITERS; ++k) {
+                    acc += tile[(lid + k) % WG];
+                }
+                a[item.get_global_id(0)] = acc;
+            });
+        });
+    };
+    local_reads();
+    q.wait();
+    p.local_bandwidth_gbs = static_cast<double>(LOCAL_GLOBAL) * ITERS * sizeof(float) / best_seconds(q, 3, local_reads) / 1e9;
+
+    // Peak FLOP/s: 8 independent FMA chains per work-item, 2 FLOPs per FMA
+    const size_t FMA_GLOBAL = 1 << 19;
+    const int FMA_ITERS = 512;
+    const float mul = 0.999999f;
+    const float add = 1e-7f;
+    auto fma_chain = [&] {
+        q.parallel_for<class FmaChainKernel>(sycl::range<1>{FMA_GLOBAL}, [=](sycl::id<1> idx) {
+            float x0 = static_cast<float>(idx[0]) * 1e-6f;
+            float x1 = x0 + 1.0f, x2 = x0 + 2.0f, x3 = x0 + 3.0f;
+            float x4 = x0 + 4.0f, x5 = x0 + 5.0f, x6 = x0 + 6.0f, x7 = x0 + 7.0f;
+            for (int k = 0; k < FMA_ITERS; ++k) {
+                x0 = sycl::fma(x0, mul, add);
+                x1 = sycl::fma(x1, mul, add);
+                x2 = sycl::fma(x2, mul, add);
+                x3 = sycl::fma(x3, mul, add);
+                x4 = sycl::fma(x4, mul, add);
+                x5 = sycl::fma(x5, mul, add);
+                x6 = sycl::fma(x6, mul, add);
+                x7 = sycl::fma(x7, mul, add);
+            }
+            b[idx] = x0 + x1 + x2 + x3 + x4 + x5 + x6 + x7;
+        });
+    };
+    fma_chain();
+    q.wait();
+    p.peak_gflops = 2.0 * 8 * FMA_ITERS * static_cast<double>(FMA_GLOBAL) / best_seconds(q, 3, fma_chain) / 1e9;
+
+    sycl::free(a, q);
+    sycl::free(b, q);
+
+    // Atomic throughput: relaxed fetch_add, NUM_COUNTERS-way contention
+    const size_t ATOMIC_OPS = 1 << 22;
+    const size_t NUM_COUNTERS = 1024;
+    unsigned* counters = sycl::malloc_device<unsigned>(NUM_COUNTERS, q);
+    auto atomics = [&] {
+        q.parallel_for<class AtomicAddKernel>(sycl::range<1>{ATOMIC_OPS}, [=](sycl::id<1> i) {
+            sycl::atomic_ref<unsigned, sycl::memory_order::relaxed, sycl::memory_scope::device,
+                             sycl::access::address_space::global_space>
+                ref{counters[i[0] % NUM_COUNTERS]};
+            ref.fetch_add(1u);
+        });
+    };
+    q.memset(counters, 0, NUM_COUNTERS * sizeof(unsigned));
+    atomics(); // warm-up
+    q.wait();
+    q.memset(counters, 0, NUM_COUNTERS * sizeof(unsigned)).wait();
+    t0 = clock_type::now();
+    atomics();
+    q.wait();
+    p.atomic_gops = static_cast<double>(ATOMIC_OPS) / seconds_since(t0) / 1e9;
+    std::vector<unsigned> h(NUM_COUNTERS);
+    q.memcpy(h.data(), counters, NUM_COUNTERS * sizeof(unsigned)).wait();
+    for (unsigned c : h) {
+        ok = ok && c == ATOMIC_OPS / NUM_COUNTERS;
+    }
+    sycl::free(counters, q);
+
+    return p;
+}
+
+void print_profiles(const std::vector<device_profile>& profiles) {
+    std::cout << std::left << std::setw(28) << "Device"
+              << std::setw(12) << "Backend"
+              << std::right << std::setw(10) << "GB/s"
+              << std::setw(12) << "local GB/s"
+              << std::setw(10) << "GFLOP/s"
+              << std::setw(12) << "atomic G/s"
+              << std::setw(12) << "launch us"
+              << std::setw(10) << "JIT ms" << std::endl;
+    for (const auto& p : profiles) {
+        std::cout << std::left << std::setw(28) << p.name.substr(0, 27)
+                  << std::setw(12) << p.backend
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << p.bandwidth_gbs
+                  << std::setw(12) << p.local_bandwidth_gbs
+                  << std::setw(10) << p.peak_gflops
+                  << std::setprecision(3) << std::setw(12) << p.atomic_gops
+                  << std::setprecision(1) << std::setw(12) << p.launch_latency_us
+                  << std::setw(10) << p.jit_latency_ms << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    bool refresh = argc > 1 && std::string{argv[1]} == "--refresh";
+    const std::string path = profile_path();
+    std::vector<sycl::device> devices = sycl::device::get_devices();
+
+    // Reuse the cache if it covers every device on this machine
+    std::vector<device_profile> cached = read_profiles(path);
+    bool cache_complete = !cached.empty();
+    for (const auto& dev : devices) {
+        std::string key = device_key(dev);
+        cache_complete = cache_complete && std::any_of(cached.begin(), cached.end(),
+                                                       [&](const device_profile& p) { return p.key == key; });
+    }
+    if (cache_complete && !refresh) {
+        std::cout << "Cached device profile: " << path << " (--refresh to measure again)" << std::endl;
+        print_profiles(cached);
+        return 0;
+    }
+
+    std::cout << "Measuring " << devices.size() << " device(s)..." << std::endl;
+    bool ok = true;
+    std::vector<device_profile> profiles;
+    for (const auto& dev : devices) {
+        profiles.push_back(measure(dev, ok));
+    }
+    print_profiles(profiles);
+
+    bool written = write_profiles(path, profiles);
+    std::cout << (written ? "Profile written to " : "Failed to write ") << path << std::endl;
+
+    std::cout << "Device profiler: " << (ok && written ? "OK" : "FAILED") << std::endl;
+    return ok && written ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+#include <sycl/sycl.hpp>
+#define ACPP_EXT_EXPLICIT_BUFFER_POLICIES
+#include <hipSYCL/sycl/buffer_explicit_behavior.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Buffer factory policy benchmark
+//
+// buffer_policies shows what each factory does; this example measures what each one costs.
+// Every factory goes through the same life cycle and each phase is timed separately:
+//   construct  - the factory call itself
+//   first      - first kernel + wait (includes the initial host->device transfer for views)
+//   repeat     - average of further kernels on data already resident on the device
+//   destroy    - destructor plus q.wait(), so queued async writebacks are included
+// The writeback column reports whether the host data actually changed afterwards. A plain view
+// can show "yes" on the CPU backend, where the host pointer itself serves as device memory.
+
+using clock_type = std::chrono::high_resolution_clock;
+
+struct policy_times {
+    double construct_us = 0.0;
+    double first_ms = 0.0;
+    double repeat_ms = 0.0;
+    double destroy_ms = 0.0;
+    bool wrote_back = false;
+};
+
+double ms_between(clock_type::time_point a, clock_type::time_point b) {
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+template <class Buffer>
+void touch(sycl::queue& q, Buffer& buf, size_t n) {
+    q.submit([&](sycl::handler& cgh) {
+        auto acc = buf.template get_access<sycl::access_mode::read_write>(cgh);
+        cgh.parallel_for(sycl::range<1>{n}, [=](sycl::id<1> i) {
+            acc[i] = acc[i] + 1.0f;
+        });
+    });
+}
+
+template <class Factory>
+policy_times time_policy(sycl::queue& q, std::vector<float>& host, size_t n, int reps, Factory make) {
+    std::fill(host.begin(), host.end(), 0.0f);
+    policy_times t;
+
+    auto t0 = clock_type::now();
+    clock_type::time_point t3;
+    {
+        auto buf = make();
+        auto t1 = clock_type::now();
+
+        touch(q, buf, n);
+        q.wait();
+        auto t2 = clock_type::now();
+
+        for (int r = 0; r < reps; ++r) {
+            touch(q, buf, n);
+        }
+        q.wait();
+        t3 = clock_type::now();
+
+        t.construct_us = ms_between(t0, t1) * 1000.0;
+        t.first_ms = ms_between(t1, t2);
+        t.repeat_ms = ms_between(t2, t3) / reps;
+    } // buffer destroyed here
+    q.wait();
+    auto t4 = clock_type::now();
+
+    t.destroy_ms = ms_between(t3, t4);
+    t.wrote_back = host[0] == static_cast<float>(reps + 1) && host[n - 1] == static_cast<float>(reps + 1);
+    return t;
+}
+
+void print_row(const std::string& device, const std::string& policy, size_t n, const policy_times& t) {
+    std::cout << std::left << std::setw(20) << device.substr(0, 19)
+              << std::setw(26) << policy
+              << std::right << std::setw(10) << n
+              << std::fixed << std::setprecision(1) << std::setw(14) << t.construct_us
+              << std::setprecision(3) << std::setw(12) << t.first_ms
+              << std::setw(12) << t.repeat_ms
+              << std::setw(12) << t.destroy_ms
+              << std::setw(11) << (t.wrote_back ? "yes" : "no") << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    // Optional: largest size in elements (default 16M)
+    size_t max_n = 16 * 1024 * 1024;
+    if (argc > 1) {
+        try {
+            max_n = std::stoull(argv[1]);
+        } catch (const std::exception& e) {
+            std::cerr << "Error parsing max N: " << e.what() << std::endl;
+            return 1;
+        }
+        if (max_n == 0) {
+            std::cerr << "Error: max N must be at least 1" << std::endl;
+            return 1;
+        }
+    }
+    const int REPS = 10;
+
+    std::cout << std::left << std::setw(20) << "Device"
+              << std::setw(26) << "Policy"
+              << std::right << std::setw(10) << "N"
+              << std::setw(14) << "construct us"
+              << std::setw(12) << "first ms"
+              << std::setw(12) << "repeat ms"
+              << std::setw(12) << "destroy ms"
+              << std::setw(11) << "writeback" << std::endl;
+
+    bool ok = true;
+    for (const auto& dev : sycl::device::get_devices()) {
+        sycl::queue q{dev, sycl::property_list{sycl::property::queue::in_order{}}};
+        std::string name = dev.get_info<sycl::info::device::name>();
+
+        bool warmed_up = false;
+        // At least one size, even when max_n is below the usual 4096 starting point
+        for (size_t n = std::min<size_t>(4096, max_n); n <= max_n; n *= 16) {
+            std::vector<float> host(n);
+            auto r = sycl::range<1>{n};
+            float* p = host.data();
+
+            // Warm-up: JIT-compile the kernel for this device outside the measurements
+            if (!warmed_up) {
+                time_policy(q, host, n, 1, [&] { return sycl::make_sync_buffer<float>(r); });
+                warmed_up = true;
+            }
+
+            policy_times t;
+            t = time_policy(q, host, n, REPS, [&] { return sycl::make_sync_buffer<float>(r); });
+            print_row(name, "make_sync_buffer", n, t);
+            t = time_policy(q, host, n, REPS, [&] { return sycl::make_async_buffer<float>(r); });
+            print_row(name, "make_async_buffer", n, t);
+            t = time_policy(q, host, n, REPS, [&] { return sycl::make_sync_view(p, r); });
+            print_row(name, "make_sync_view", n, t);
+            t = time_policy(q, host, n, REPS, [&] { return sycl::make_async_view(p, r); });
+            print_row(name, "make_async_view", n, t);
+            t = time_policy(q, host, n, REPS, [&] { return sycl::make_sync_writeback_view(p, r); });
+            print_row(name, "make_sync_writeback_view", n, t);
+            ok = ok && t.wrote_back;
+            t = time_policy(q, host, n, REPS, [&] { return sycl::make_async_writeback_view(p, r, q); });
+            print_row(name, "make_async_writeback_view", n, t);
+            ok = ok && t.wrote_back;
+        }
+    }
+
+    // Writeback views must update the host data. Plain views promise nothing either way: on
+    // the CPU backend the runtime may use the host pointer itself as the device allocation.
+    std::cout << "Buffer policy benchmark: " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
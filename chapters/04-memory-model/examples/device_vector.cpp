@@ -0,0 +1,303 @@
+#include <sycl/sycl.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <new>
+#include <utility>
+#include <vector>
+
+// STL-style USM allocator
+//
+// Satisfies the C++ Allocator requirements (value_type, allocate, deallocate, rebind via the
+// converting constructor, equality). The USM kind is a template parameter, so the same
+// container code can target device, shared or host memory:
+//   usm_allocator<float, sycl::usm::alloc::device>  - device-only, fastest for kernels
+//   usm_allocator<float, sycl::usm::alloc::shared>  - migrates on demand, host-accessible
+//   usm_allocator<float, sycl::usm::alloc::host>    - pinned host memory, device-accessible
+// Device allocations are not host-accessible, so only shared/host allocators may be used with
+// std::vector. device_vector below works with all three.
+template <class T, sycl::usm::alloc Kind>
+class usm_allocator {
+public:
+    using value_type = T;
+    static constexpr sycl::usm::alloc kind = Kind;
+
+    explicit usm_allocator(const sycl::queue& q) : q_(q) {}
+
+    template <class U>
+    usm_allocator(const usm_allocator<U, Kind>& other) : q_(other.queue()) {}
+
+    T* allocate(size_t n) {
+        T* ptr = nullptr;
+        if constexpr (Kind == sycl::usm::alloc::device) {
+            ptr = sycl::malloc_device<T>(n, q_);
+        } else if constexpr (Kind == sycl::usm::alloc::shared) {
+            ptr = sycl::malloc_shared<T>(n, q_);
+        } else {
+            ptr = sycl::malloc_host<T>(n, q_);
+        }
+        if (ptr == nullptr && n != 0) {
+            throw std::bad_alloc{};
+        }
+        return ptr;
+    }
+
+    void deallocate(T* ptr, size_t) {
+        sycl::free(ptr, q_);
+    }
+
+    const sycl::queue& queue() const { return q_; }
+
+    template <class U>
+    bool operator==(const usm_allocator<U, Kind>& other) const {
+        return q_.get_context() == other.queue().get_context();
+    }
+
+    template <class U>
+    bool operator!=(const usm_allocator<U, Kind>& other) const {
+        return !(*this == other);
+    }
+
+private:
+    sycl::queue q_;
+};
+
+// RAII USM array
+//
+// Owns a USM allocation and frees it on destruction - no manual sycl::free calls. All data
+// movement is asynchronous and returns a sycl::event, so callers decide when to wait.
+// Move-only: copying would silently duplicate device memory.
+//
+// resize() is asynchronous too. The old storage cannot be freed until the copy into the new
+// storage has finished, so it is retired together with the copy's event and released the next
+// time the vector synchronizes (wait(), resize(), destruction).
+template <class T, class Allocator = usm_allocator<T, sycl::usm::alloc::device>>
+class device_vector {
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+
+    device_vector(sycl::queue& q, size_t count)
+        : q_(q), alloc_(q), data_(alloc_.allocate(count)), size_(count) {}
+
+    device_vector(sycl::queue& q, size_t count, const T& value) : device_vector(q, count) {
+        fill(value);
+    }
+
+    ~device_vector() {
+        if (data_ != nullptr || !retired_.empty()) {
+            q_.wait();
+            release_retired();
+            if (data_ != nullptr) {
+                alloc_.deallocate(data_, size_);
+            }
+        }
+    }
+
+    device_vector(const device_vector&) = delete;
+    device_vector& operator=(const device_vector&) = delete;
+
+    device_vector(device_vector&& other) noexcept
+        : q_(other.q_), alloc_(other.alloc_),
+          data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)),
+          retired_(std::move(other.retired_)) {
+        other.retired_.clear();
+    }
+
+    device_vector& operator=(device_vector&& other) noexcept {
+        // The previous contents are released when tmp goes out of scope
+        device_vector tmp{std::move(other)};
+        swap(tmp);
+        return *this;
+    }
+
+    void swap(device_vector& other) noexcept {
+        std::swap(q_, other.q_);
+        std::swap(alloc_, other.alloc_);
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(retired_, other.retired_);
+    }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+    size_t size_bytes() const { return size_ * sizeof(T); }
+    bool empty() const { return size_ == 0; }
+    sycl::queue& get_queue() { return q_; }
+
+    sycl::event fill(const T& value, const std::vector<sycl::event>& deps = {}) {
+        T* ptr = data_;
+        T v = value;
+        return q_.submit([&](sycl::handler& cgh) {
+            cgh.depends_on(deps);
+            cgh.parallel_for(sycl::range<1>{size_}, [=](sycl::id<1> i) {
+                ptr[i] = v;
+            });
+        });
+    }
+
+    // Copy size() elements from host memory. `src` must stay alive until the event completes.
+    sycl::event copy_from_host(const T* src, const std::vector<sycl::event>& deps = {}) {
+        return q_.memcpy(data_, src, size_bytes(), deps);
+    }
+
+    sycl::event copy_from_host(const std::vector<T>& src, const std::vector<sycl::event>& deps = {}) {
+        return q_.memcpy(data_, src.data(), std::min(src.size(), size_) * sizeof(T), deps);
+    }
+
+    // Copy size() elements into host memory. `dst` must stay alive until the event completes.
+    sycl::event copy_to_host(T* dst, const std::vector<sycl::event>& deps = {}) {
+        return q_.memcpy(dst, data_, size_bytes(), deps);
+    }
+
+    sycl::event copy_to_host(std::vector<T>& dst, const std::vector<sycl::event>& deps = {}) {
+        dst.resize(size_);
+        return q_.memcpy(dst.data(), data_, size_bytes(), deps);
+    }
+
+    // Reallocate to `count` elements, preserving the first min(size(), count) elements.
+    // New elements are uninitialized. Returns the event of the preserving copy.
+    sycl::event resize(size_t count, const std::vector<sycl::event>& deps = {}) {
+        release_retired();
+        if (count == size_) {
+            return q_.submit([&](sycl::handler& cgh) {
+                cgh.depends_on(deps);
+                cgh.single_task([]() {});
+            });
+        }
+
+        T* new_data = alloc_.allocate(count);
+        sycl::event copied = q_.memcpy(new_data, data_, std::min(size_, count) * sizeof(T), deps);
+
+        if (data_ != nullptr) {
+            retired_.push_back({data_, size_, copied});
+        }
+        data_ = new_data;
+        size_ = count;
+        return copied;
+    }
+
+    void wait() {
+        q_.wait();
+        release_retired();
+    }
+
+private:
+    struct retired_block {
+        T* ptr;
+        size_t count;
+        sycl::event last_use;
+    };
+
+    void release_retired() {
+        auto done = std::partition(retired_.begin(), retired_.end(), [](const retired_block& r) {
+            return r.last_use.template get_info<sycl::info::event::command_execution_status>() !=
+                   sycl::info::event_command_status::complete;
+        });
+        for (auto it = done; it != retired_.end(); ++it) {
+            alloc_.deallocate(it->ptr, it->count);
+        }
+        retired_.erase(done, retired_.end());
+    }
+
+    sycl::queue q_;
+    Allocator alloc_;
+    T* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<retired_block> retired_;
+};
+
+template <class T>
+using shared_vector = device_vector<T, usm_allocator<T, sycl::usm::alloc::shared>>;
+
+bool check_all(const float* data, size_t n, float expected) {
+    for (size_t i = 0; i < n; ++i) {
+        if (data[i] != expected) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    const size_t N = 1024 * 1024; // 1M elements
+    sycl::queue q{sycl::default_selector_v, sycl::property_list{sycl::property::queue::in_order{}}};
+    std::cout << "Using device: " << q.get_device().get_info<sycl::info::device::name>() << std::endl;
+
+    bool ok = true;
+
+    // Pattern A - device_vector: same vector add as usm_vector_add, without staging vectors
+    // for the inputs and without any sycl::free calls
+    {
+        device_vector<float> a{q, N, 1.0f};
+        device_vector<float> b{q, N, 2.0f};
+        device_vector<float> c{q, N};
+
+        float* pa = a.data();
+        float* pb = b.data();
+        float* pc = c.data();
+        q.parallel_for(sycl::range<1>{N}, [=](sycl::id<1> i) {
+            pc[i] = pa[i] + pb[i];
+        });
+
+        std::vector<float> h_c;
+        c.copy_to_host(h_c).wait();
+        bool pass = check_all(h_c.data(), N, 3.0f);
+        std::cout << "device_vector add: " << (pass ? "OK" : "FAILED") << std::endl;
+        ok = ok && pass;
+    } // a, b, c freed here
+
+    // Pattern B - copy_from_host from an existing host array, then grow asynchronously
+    {
+        std::vector<float> h_in(N, 5.0f);
+        device_vector<float> v{q, N};
+        sycl::event uploaded = v.copy_from_host(h_in);
+
+        // Double the size; the first N elements are preserved by a device-side copy
+        sycl::event grown = v.resize(2 * N, {uploaded});
+        float* pv = v.data();
+        q.submit([&](sycl::handler& cgh) {
+            cgh.depends_on(grown);
+            cgh.parallel_for(sycl::range<1>{N}, [=](sycl::id<1> i) {
+                pv[N + i[0]] = 7.0f;
+            });
+        });
+
+        std::vector<float> h_out;
+        v.copy_to_host(h_out).wait();
+        bool pass = h_out.size() == 2 * N && check_all(h_out.data(), N, 5.0f) &&
+                    check_all(h_out.data() + N, N, 7.0f);
+        std::cout << "device_vector resize: " << (pass ? "OK" : "FAILED") << std::endl;
+        ok = ok && pass;
+    }
+
+    // Pattern C - shared_vector: host writes directly, no staging copy at all
+    {
+        shared_vector<float> s{q, N};
+        std::fill(s.data(), s.data() + N, 4.0f);
+
+        float* ps = s.data();
+        q.parallel_for(sycl::range<1>{N}, [=](sycl::id<1> i) {
+            ps[i] *= 2.0f;
+        }).wait();
+
+        bool pass = check_all(s.data(), N, 8.0f);
+        std::cout << "shared_vector in-place: " << (pass ? "OK" : "FAILED") << std::endl;
+        ok = ok && pass;
+    }
+
+    // Pattern D - move-only ownership transfer
+    {
+        device_vector<float> src{q, N, 9.0f};
+        device_vector<float> dst = std::move(src);
+
+        std::vector<float> h;
+        dst.copy_to_host(h).wait();
+        bool pass = src.data() == nullptr && src.size() == 0 && check_all(h.data(), N, 9.0f);
+        std::cout << "device_vector move: " << (pass ? "OK" : "FAILED") << std::endl;
+        ok = ok && pass;
+    }
+
+    return ok ? 0 : 1;
+}
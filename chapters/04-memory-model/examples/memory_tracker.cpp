@@ -0,0 +1,351 @@
+#include <sycl/sycl.hpp>
+#define ACPP_EXT_EXPLICIT_BUFFER_POLICIES
+#include <hipSYCL/sycl/buffer_explicit_behavior.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Device memory footprint tracker
+//
+// Neither USM nor buffers tell you how much device memory your program holds right now, so
+// batch sizes end up being guessed. memory_tracker keeps per-device accounting of everything
+// allocated through the tracked:: wrappers:
+//
+//   tracked::malloc_device / malloc_shared / malloc_host / free   - drop-in for the sycl:: calls
+//   tracked::adopt(q, sycl::make_*_buffer(...))                   - buffers, counted for q's device
+//
+// It records live bytes, the high-water mark and allocation counts, prints a report when the
+// program exits (including anything still allocated), and answers "how many items fit?" so a
+// loop can size its batches from the memory that is actually left.
+
+enum class allocation_kind { device, shared, host, buffer };
+constexpr int NUM_KINDS = 4;
+
+const char* kind_name(allocation_kind k) {
+    switch (k) {
+        case allocation_kind::device: return "device";
+        case allocation_kind::shared: return "shared";
+        case allocation_kind::host: return "host";
+        case allocation_kind::buffer: return "buffer";
+    }
+    return "";
+}
+
+struct device_stats {
+    size_t live_bytes = 0;  // device-resident bytes: device, shared and buffer allocations
+    size_t peak_bytes = 0;  // high-water mark of live_bytes
+    size_t live_by_kind[NUM_KINDS] = {};
+    size_t allocations = 0; // total allocation calls
+    size_t frees = 0;
+    size_t live_allocations() const { return allocations - frees; }
+};
+
+class memory_tracker {
+public:
+    static memory_tracker& instance() {
+        static memory_tracker tracker;
+        return tracker;
+    }
+
+    ~memory_tracker() {
+        if (!devices_.empty()) {
+            report(std::cout);
+        }
+    }
+
+    void record_alloc(const sycl::device& dev, const void* ptr, size_t bytes, allocation_kind kind) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        device_stats& s = entry(dev).stats;
+        s.allocations++;
+        s.live_by_kind[static_cast<int>(kind)] += bytes;
+        // Pinned host memory is not device memory; it is reported but not counted as live
+        if (kind != allocation_kind::host) {
+            s.live_bytes += bytes;
+            s.peak_bytes = std::max(s.peak_bytes, s.live_bytes);
+        }
+        live_[ptr] = live_allocation{dev, bytes, kind};
+    }
+
+    void record_free(const void* ptr) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        auto it = live_.find(ptr);
+        if (it == live_.end()) {
+            return; // not allocated through the tracker
+        }
+        const live_allocation& a = it->second;
+        device_stats& s = entry(a.dev).stats;
+        s.frees++;
+        s.live_by_kind[static_cast<int>(a.kind)] -= a.bytes;
+        if (a.kind != allocation_kind::host) {
+            s.live_bytes -= a.bytes;
+        }
+        live_.erase(it);
+    }
+
+    // Query API
+
+    device_stats stats(const sycl::device& dev) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return entry(dev).stats;
+    }
+
+    size_t live_bytes(const sycl::device& dev) { return stats(dev).live_bytes; }
+    size_t peak_bytes(const sycl::device& dev) { return stats(dev).peak_bytes; }
+
+    // Memory the program may use on dev. Defaults to global_mem_size; lower it to leave room
+    // for other processes or to test batching logic on a large device.
+    void set_budget(const sycl::device& dev, size_t bytes) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        entry(dev).budget = bytes;
+    }
+
+    size_t budget(const sycl::device& dev) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return entry(dev).budget;
+    }
+
+    size_t available_bytes(const sycl::device& dev) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        const device_entry& e = entry(dev);
+        return e.budget > e.stats.live_bytes ? e.budget - e.stats.live_bytes : 0;
+    }
+
+    // Largest batch whose per-item footprint fits into the available memory. headroom keeps a
+    // fraction free for allocations the tracker cannot see (runtime scratch, kernel arguments).
+    size_t max_batch_items(const sycl::device& dev, size_t bytes_per_item, double headroom = 0.9) {
+        auto usable = static_cast<size_t>(static_cast<double>(available_bytes(dev)) * headroom);
+        return usable / bytes_per_item;
+    }
+
+    void report(std::ostream& os) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        os << std::endl << "Device memory report" << std::endl;
+        os << std::left << std::setw(28) << "Device"
+           << std::right << std::setw(12) << "peak MiB"
+           << std::setw(12) << "live MiB"
+           << std::setw(12) << "allocs"
+           << std::setw(12) << "frees"
+           << std::setw(12) << "leaked" << std::endl;
+        for (const auto& e : devices_) {
+            const device_stats& s = e.stats;
+            os << std::left << std::setw(28) << e.name.substr(0, 27)
+               << std::right << std::fixed << std::setprecision(1)
+               << std::setw(12) << static_cast<double>(s.peak_bytes) / (1 << 20)
+               << std::setw(12) << static_cast<double>(s.live_bytes) / (1 << 20)
+               << std::setw(12) << s.allocations
+               << std::setw(12) << s.frees
+               << std::setw(12) << s.live_allocations() << std::endl;
+            for (int k = 0; k < NUM_KINDS; ++k) {
+                if (s.live_by_kind[k] > 0) {
+                    os << "    still allocated (" << kind_name(static_cast<allocation_kind>(k)) << "): "
+                       << s.live_by_kind[k] << " bytes" << std::endl;
+                }
+            }
+        }
+    }
+
+private:
+    struct device_entry {
+        sycl::device dev;
+        std::string name;
+        size_t budget;
+        device_stats stats;
+    };
+    struct live_allocation {
+        sycl::device dev;
+        size_t bytes;
+        allocation_kind kind;
+    };
+
+    memory_tracker() = default;
+
+    // A handful of devices at most, so a linear search is fine
+    device_entry& entry(const sycl::device& dev) {
+        for (auto& e : devices_) {
+            if (e.dev == dev) {
+                return e;
+            }
+        }
+        devices_.push_back(device_entry{dev, dev.get_info<sycl::info::device::name>(),
+                                        static_cast<size_t>(dev.get_info<sycl::info::device::global_mem_size>()),
+                                        device_stats{}});
+        return devices_.back();
+    }
+
+    std::mutex mutex_;
+    std::vector<device_entry> devices_;
+    std::unordered_map<const void*, live_allocation> live_;
+};
+
+namespace tracked {
+
+template <class T>
+T* malloc_device(size_t count, sycl::queue& q) {
+    T* p = sycl::malloc_device<T>(count, q);
+    if (p) {
+        memory_tracker::instance().record_alloc(q.get_device(), p, count * sizeof(T), allocation_kind::device);
+    }
+    return p;
+}
+
+template <class T>
+T* malloc_shared(size_t count, sycl::queue& q) {
+    T* p = sycl::malloc_shared<T>(count, q);
+    if (p) {
+        memory_tracker::instance().record_alloc(q.get_device(), p, count * sizeof(T), allocation_kind::shared);
+    }
+    return p;
+}
+
+template <class T>
+T* malloc_host(size_t count, sycl::queue& q) {
+    T* p = sycl::malloc_host<T>(count, q);
+    if (p) {
+        memory_tracker::instance().record_alloc(q.get_device(), p, count * sizeof(T), allocation_kind::host);
+    }
+    return p;
+}
+
+inline void free(void* ptr, sycl::queue& q) {
+    memory_tracker::instance().record_free(ptr);
+    sycl::free(ptr, q);
+}
+
+// A buffer that is counted against q's device for as long as it lives. The runtime allocates
+// device memory lazily on first use, so this is the worst case from creation on. Copies would
+// share the same storage, so tracked buffers are move-only.
+template <class T, int Dim>
+class buffer : public sycl::buffer<T, Dim> {
+public:
+    buffer(const sycl::device& dev, sycl::buffer<T, Dim> buf)
+        : sycl::buffer<T, Dim>(std::move(buf)), key_(new char) {
+        memory_tracker::instance().record_alloc(dev, key_, this->size() * sizeof(T), allocation_kind::buffer);
+    }
+
+    ~buffer() {
+        if (key_) {
+            memory_tracker::instance().record_free(key_);
+            delete key_;
+        }
+    }
+
+    buffer(buffer&& other) noexcept : sycl::buffer<T, Dim>(std::move(other)), key_(other.key_) {
+        other.key_ = nullptr;
+    }
+
+    buffer(const buffer&) = delete;
+    buffer& operator=(const buffer&) = delete;
+    buffer& operator=(buffer&&) = delete;
+
+private:
+    char* key_; // unique address identifying this buffer in the tracker
+};
+
+template <class T, int Dim>
+buffer<T, Dim> adopt(sycl::queue& q, sycl::buffer<T, Dim> buf) {
+    return buffer<T, Dim>{q.get_device(), std::move(buf)};
+}
+
+} // namespace tracked
+
+int main(int argc, char* argv[]) {
+    // Optional: device memory budget in MiB (default 256) - small enough to force batching
+    size_t budget_mib = 256;
+    if (argc > 1) {
+        try {
+            budget_mib = std::stoull(argv[1]);
+        } catch (const std::exception& e) {
+            std::cerr << "Error parsing budget: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    const size_t N = 128 * 1024 * 1024; // 512 MiB of input floats, more than the default budget
+    const size_t LUT_SIZE = 4 * 1024 * 1024;
+
+    sycl::queue q{sycl::default_selector_v, sycl::property_list{sycl::property::queue::in_order{}}};
+    auto dev = q.get_device();
+    std::cout << "Using device: " << dev.get_info<sycl::info::device::name>() << std::endl;
+
+    auto& tracker = memory_tracker::instance();
+    const size_t budget = budget_mib << 20;
+    tracker.set_budget(dev, std::min(budget, tracker.budget(dev)));
+
+    std::vector<float> input(N);
+    for (size_t i = 0; i < N; ++i) {
+        input[i] = static_cast<float>(i % 1024);
+    }
+    std::vector<float> output(N);
+
+    bool ok = true;
+    {
+        // A long-lived lookup table reduces what is left for the batches
+        auto lut = tracked::adopt(q, sycl::make_async_buffer<float>(sycl::range<1>{LUT_SIZE}));
+        q.submit([&](sycl::handler& cgh) {
+            auto acc = lut.get_access<sycl::access_mode::discard_write>(cgh);
+            cgh.parallel_for(sycl::range<1>{LUT_SIZE}, [=](sycl::id<1> i) {
+                acc[i] = (i[0] % 2 == 0) ? 2.0f : 3.0f;
+            });
+        });
+
+        // Adaptive batching: each batch needs an input and an output float on the device
+        size_t batches = 0;
+        size_t offset = 0;
+        while (offset < N) {
+            size_t batch = std::min(tracker.max_batch_items(dev, 2 * sizeof(float)), N - offset);
+            if (batch == 0) {
+                std::cerr << "Budget too small for a single item" << std::endl;
+                return 1;
+            }
+            float* d_in = tracked::malloc_device<float>(batch, q);
+            float* d_out = tracked::malloc_device<float>(batch, q);
+            if (!d_in || !d_out) {
+                throw std::bad_alloc{};
+            }
+
+            q.memcpy(d_in, input.data() + offset, batch * sizeof(float));
+            q.submit([&](sycl::handler& cgh) {
+                auto table = lut.get_access<sycl::access_mode::read>(cgh);
+                cgh.parallel_for(sycl::range<1>{batch}, [=](sycl::id<1> i) {
+                    d_out[i] = d_in[i] * table[(offset + i[0]) % LUT_SIZE];
+                });
+            });
+            q.memcpy(output.data() + offset, d_out, batch * sizeof(float));
+            q.wait();
+
+            tracked::free(d_in, q);
+            tracked::free(d_out, q);
+            offset += batch;
+            ++batches;
+        }
+
+        device_stats s = tracker.stats(dev);
+        std::cout << "Processed " << (N * sizeof(float) >> 20) << " MiB in " << batches << " batches, budget "
+                  << (tracker.budget(dev) >> 20) << " MiB, peak " << (s.peak_bytes >> 20) << " MiB" << std::endl;
+
+        bool within_budget = s.peak_bytes <= tracker.budget(dev);
+        std::cout << "Peak within budget: " << (within_budget ? "OK" : "FAILED") << std::endl;
+        bool only_lut_live = s.live_allocations() == 1 && s.live_bytes == LUT_SIZE * sizeof(float);
+        std::cout << "Batch allocations released: " << (only_lut_live ? "OK" : "FAILED") << std::endl;
+        ok = within_budget && only_lut_live;
+    }
+
+    for (size_t i : {size_t{0}, size_t{1}, N / 2 + 1, N - 1}) {
+        float expected = input[i] * ((i % LUT_SIZE) % 2 == 0 ? 2.0f : 3.0f);
+        if (output[i] != expected) {
+            ok = false;
+        }
+    }
+    bool all_freed = tracker.live_bytes(dev) == 0;
+    std::cout << "Results and final footprint: " << (ok && all_freed ? "OK" : "FAILED") << std::endl;
+
+    // The tracker prints its report here, when it is destroyed at exit
+    return ok && all_freed ? 0 : 1;
+}
@@ -0,0 +1,273 @@
+#include <sycl/sycl.hpp>
+#define ACPP_EXT_EXPLICIT_BUFFER_POLICIES
+#include <hipSYCL/sycl/buffer_explicit_behavior.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Memory-mapped file input
+//
+// The usual way to get a file into a kernel is read() into a std::vector, then wrap the vector
+// in a view. That copies every byte twice on the host: page cache -> vector, then vector ->
+// device. mmap() maps the page cache straight into the address space, so the view can point
+// at the file contents directly and the vector copy disappears.
+//
+// mapped_file is an RAII owner for a read-only mapping. madvise(MADV_SEQUENTIAL) tells the
+// kernel to read ahead aggressively and drop pages behind the reader, which is the access
+// pattern of a streaming reduction.
+class mapped_file {
+public:
+    explicit mapped_file(const std::string& path) {
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            throw std::system_error{errno, std::generic_category(), "open " + path};
+        }
+        struct stat st{};
+        if (::fstat(fd_, &st) != 0) {
+            int err = errno;
+            ::close(fd_);
+            throw std::system_error{err, std::generic_category(), "fstat " + path};
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ == 0) {
+            ::close(fd_);
+            throw std::runtime_error{"mapped_file: " + path + " is empty"};
+        }
+        data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (data_ == MAP_FAILED) {
+            int err = errno;
+            ::close(fd_);
+            throw std::system_error{err, std::generic_category(), "mmap " + path};
+        }
+        ::madvise(data_, size_, MADV_SEQUENTIAL);
+    }
+
+    ~mapped_file() {
+        ::munmap(data_, size_);
+        ::close(fd_);
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    template <class T>
+    const T* data() const { return static_cast<const T*>(data_); }
+
+    template <class T>
+    size_t count() const { return size_ / sizeof(T); }
+
+private:
+    int fd_ = -1;
+    void* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Evict a file from the page cache so every timed run starts cold. POSIX_FADV_DONTNEED skips
+// dirty pages, so a freshly written file is flushed to disk first. Returns false if the pages
+// could not be dropped (the timed run then reads from the page cache).
+bool drop_page_cache(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = ::fdatasync(fd) == 0 && ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    ::close(fd);
+    return ok;
+}
+
+// MemAvailable from /proc/meminfo in MiB, roughly what the page cache can grow to; 0 if unknown
+size_t available_memory_mib() {
+    std::ifstream in{"/proc/meminfo"};
+    std::string key;
+    size_t kib = 0;
+    while (in >> key >> kib) {
+        if (key == "MemAvailable:") {
+            return kib / 1024;
+        }
+        in.ignore(64, '\n');
+    }
+    return 0;
+}
+
+void generate_file(const std::string& path, size_t mib) {
+    std::ofstream out{path, std::ios::binary};
+    std::vector<float> block(1 << 18); // 1 MiB of floats
+    for (size_t m = 0; m < mib; ++m) {
+        for (size_t i = 0; i < block.size(); ++i) {
+            block[i] = static_cast<float>((m * block.size() + i) % 16);
+        }
+        out.write(reinterpret_cast<const char*>(block.data()), block.size() * sizeof(float));
+    }
+    if (!out) {
+        throw std::runtime_error{"failed to write " + path};
+    }
+}
+
+// Adds the sum of one chunk to *sum (the reduction combines with the existing value)
+template <class Buffer>
+void reduce_chunk(sycl::queue& q, Buffer& buf, size_t n, float* sum) {
+    q.submit([&](sycl::handler& cgh) {
+        auto acc = buf.template get_access<sycl::access_mode::read>(cgh);
+        cgh.parallel_for(sycl::range<1>{n}, sycl::reduction(sum, sycl::plus<float>()),
+                         [=](sycl::id<1> i, auto& s) {
+                             s += acc[i];
+                         });
+    });
+}
+
+// mmap + make_async_view: each chunk is a view straight into the mapping. The mapping outlives
+// every view, so the non-blocking async views let chunks queue up back to back.
+float sum_mmap(sycl::queue& q, const std::string& path, size_t chunk, float* d_sum) {
+    mapped_file file{path};
+    const float* data = file.data<float>();
+    const size_t n = file.count<float>();
+
+    q.memset(d_sum, 0, sizeof(float));
+    for (size_t offset = 0; offset < n; offset += chunk) {
+        size_t len = std::min(chunk, n - offset);
+        auto view = sycl::make_async_view(data + offset, sycl::range<1>{len});
+        reduce_chunk(q, view, len, d_sum);
+    }
+    // All views must be done with the mapping before it is unmapped
+    q.wait();
+
+    float sum = 0.0f;
+    q.memcpy(&sum, d_sum, sizeof(float)).wait();
+    return sum;
+}
+
+// read() + std::vector + make_sync_view: the classic path. The staging vector is reused for
+// every chunk, so each view must block on destruction before the next read() overwrites it.
+float sum_read(sycl::queue& q, const std::string& path, size_t chunk, float* d_sum) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::system_error{errno, std::generic_category(), "open " + path};
+    }
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    std::vector<float> staging(chunk);
+    q.memset(d_sum, 0, sizeof(float));
+    while (true) {
+        ssize_t got = ::read(fd, staging.data(), chunk * sizeof(float));
+        if (got <= 0) {
+            break;
+        }
+        size_t len = static_cast<size_t>(got) / sizeof(float);
+        {
+            auto view = sycl::make_sync_view(staging.data(), sycl::range<1>{len});
+            reduce_chunk(q, view, len, d_sum);
+        } // blocks until the kernel has finished reading staging
+    }
+    ::close(fd);
+
+    float sum = 0.0f;
+    q.memcpy(&sum, d_sum, sizeof(float)).wait();
+    return sum;
+}
+
+int main(int argc, char* argv[]) {
+    // Usage:
+    //   mmap_input                       generate a 256 MiB temporary file and benchmark it
+    //                                    (smaller than the page cache: use --generate for a
+    //                                    file larger than MemAvailable)
+    //   mmap_input <file> [chunk MiB]    benchmark an existing file of floats
+    //   mmap_input --generate <file> <MiB>
+    try {
+        if (argc == 4 && std::string{argv[1]} == "--generate") {
+            generate_file(argv[2], std::stoull(argv[3]));
+            std::cout << "Wrote " << argv[3] << " MiB to " << argv[2] << std::endl;
+            return 0;
+        }
+
+        std::string path = "mmap_input.bin";
+        bool temporary = argc < 2;
+        size_t chunk_mib = 64;
+        if (temporary) {
+            generate_file(path, 256);
+        } else {
+            path = argv[1];
+            if (argc > 2) {
+                chunk_mib = std::stoull(argv[2]);
+            }
+        }
+        const size_t chunk = chunk_mib * (1 << 20) / sizeof(float);
+
+        sycl::queue q{sycl::default_selector_v, sycl::property_list{sycl::property::queue::in_order{}}};
+        std::cout << "Using device: " << q.get_device().get_info<sycl::info::device::name>() << std::endl;
+        float* d_sum = sycl::malloc_device<float>(1, q);
+
+        // Warm-up: JIT-compile the reduction kernel (page cache state is reset below)
+        sum_read(q, path, chunk, d_sum);
+
+        bool cold = drop_page_cache(path);
+        auto t0 = std::chrono::high_resolution_clock::now();
+        float read_sum = sum_read(q, path, chunk, d_sum);
+        auto t1 = std::chrono::high_resolution_clock::now();
+
+        cold = drop_page_cache(path) && cold;
+        auto t2 = std::chrono::high_resolution_clock::now();
+        float mmap_sum = sum_mmap(q, path, chunk, d_sum);
+        auto t3 = std::chrono::high_resolution_clock::now();
+
+        sycl::free(d_sum, q);
+
+        double read_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        double mmap_ms = std::chrono::duration<double, std::milli>(t3 - t2).count();
+        struct stat st{};
+        ::stat(path.c_str(), &st);
+        double gb = static_cast<double>(st.st_size) / 1e9;
+
+        std::cout << "File: " << path << " (" << (st.st_size >> 20) << " MiB, " << chunk_mib << " MiB chunks, "
+                  << (cold ? "page cache dropped before each run" : "page cache NOT dropped, runs may be warm")
+                  << ")" << std::endl;
+        size_t avail_mib = available_memory_mib();
+        if (avail_mib > static_cast<size_t>(st.st_size >> 20)) {
+            std::cout << "Note: the file fits in the page cache (" << avail_mib << " MiB available). For a "
+                      << "file larger than memory: mmap_input --generate big.bin " << avail_mib * 2 << std::endl;
+        }
+        std::cout << std::left << std::setw(28) << "Path"
+                  << std::right << std::setw(12) << "Time (ms)"
+                  << std::setw(10) << "GB/s"
+                  << std::setw(16) << "Sum" << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << std::left << std::setw(28) << "read() + vector + sync view"
+                  << std::right << std::setw(12) << read_ms
+                  << std::setw(10) << gb / (read_ms / 1000.0)
+                  << std::setw(16) << read_sum << std::endl;
+        std::cout << std::left << std::setw(28) << "mmap + async view"
+                  << std::right << std::setw(12) << mmap_ms
+                  << std::setw(10) << gb / (mmap_ms / 1000.0)
+                  << std::setw(16) << mmap_sum << std::endl;
+
+        if (temporary) {
+            std::remove(path.c_str());
+        }
+
+        // Both paths reduce the same data in the same chunk order
+        bool ok = std::abs(read_sum - mmap_sum) <= 1e-3f * std::max(1.0f, std::abs(read_sum));
+        std::cout << "mmap input: " << (ok ? "OK" : "FAILED") << std::endl;
+        return ok ? 0 : 1;
+
+    } catch (const sycl::exception& e) {
+        std::cout << "SYCL exception caught: " << e.what() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
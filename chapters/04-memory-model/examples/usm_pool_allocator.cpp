@@ -0,0 +1,377 @@
+#include <sycl/sycl.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Caching device memory pool
+//
+// sycl::malloc_device and sycl::free are expensive backend calls, and sycl::free is only safe
+// once every kernel that touches the allocation has finished. A loop that allocates scratch
+// memory per batch therefore pays for an allocation, a free and a q.wait() on every iteration.
+//
+// usm_device_pool keeps freed blocks around and hands them out again:
+// - Small requests are rounded up to a power-of-two size class (256 B ... 1 MiB) and served
+//   from a per-class free list.
+// - Large requests are rounded up to a multiple of 1 MiB and served best-fit from a sorted
+//   cache, accepting a cached block of at most twice the requested size.
+// - deallocate(ptr, event) is stream-ordered: the block is parked until `event` completes,
+//   so it is never handed out while a kernel still reads or writes it. No q.wait() needed.
+class usm_device_pool {
+public:
+    struct statistics {
+        size_t allocate_calls = 0;      // Calls to allocate()
+        size_t cache_hits = 0;          // Requests served from a cached block
+        size_t device_mallocs = 0;      // Calls to sycl::malloc_device
+        size_t device_frees = 0;        // Calls to sycl::free
+        size_t bytes_in_use = 0;        // Block bytes currently handed out
+        size_t bytes_cached = 0;        // Block bytes parked in the pool (free or pending)
+        size_t peak_bytes_reserved = 0; // High-water mark of in_use + cached
+    };
+
+    explicit usm_device_pool(sycl::queue& q) : q_(q) {}
+
+    usm_device_pool(const usm_device_pool&) = delete;
+    usm_device_pool& operator=(const usm_device_pool&) = delete;
+
+    ~usm_device_pool() {
+        q_.wait();
+        reclaim_completed();
+        release_cached();
+        // Blocks that were never returned are still owned by the pool
+        for (auto& [ptr, bytes] : live_) {
+            sycl::free(ptr, q_);
+        }
+    }
+
+    void* allocate(size_t bytes) {
+        ++stats_.allocate_calls;
+
+        reclaim_completed();
+        size_t block_bytes = round_up(bytes);
+        void* ptr = take_cached(block_bytes);
+
+        if (ptr == nullptr) {
+            ptr = sycl::malloc_device(block_bytes, q_);
+            if (ptr == nullptr) {
+                // Out of device memory: drain in-flight work, drop the cache and retry once
+                q_.wait();
+                reclaim_completed();
+                release_cached();
+                ptr = sycl::malloc_device(block_bytes, q_);
+                if (ptr == nullptr) {
+                    throw std::bad_alloc{};
+                }
+            }
+            ++stats_.device_mallocs;
+        } else {
+            ++stats_.cache_hits;
+            stats_.bytes_cached -= block_bytes;
+        }
+
+        live_[ptr] = block_bytes;
+        stats_.bytes_in_use += block_bytes;
+        stats_.peak_bytes_reserved =
+            std::max(stats_.peak_bytes_reserved, stats_.bytes_in_use + stats_.bytes_cached);
+        return ptr;
+    }
+
+    template <class T>
+    T* allocate(size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T)));
+    }
+
+    // Return a block once `last_use` has completed. Safe to call right after submitting the
+    // last kernel that touches `ptr`.
+    void deallocate(void* ptr, sycl::event last_use) {
+        const size_t block_bytes = release_live(ptr);
+        pending_.push_back({ptr, block_bytes, std::move(last_use)});
+    }
+
+    // Return a block that no pending work refers to.
+    void deallocate(void* ptr) {
+        const size_t block_bytes = release_live(ptr);
+        park(ptr, block_bytes);
+    }
+
+    // Give every cached block back to the device. Pending blocks are kept.
+    void release_cached() {
+        for (auto& list : small_bins_) {
+            for (void* ptr : list) {
+                sycl::free(ptr, q_);
+                ++stats_.device_frees;
+            }
+            list.clear();
+        }
+        for (auto& [bytes, ptr] : large_blocks_) {
+            sycl::free(ptr, q_);
+            ++stats_.device_frees;
+        }
+        large_blocks_.clear();
+
+        size_t pending_bytes = 0;
+        for (const auto& p : pending_) {
+            pending_bytes += p.bytes;
+        }
+        stats_.bytes_cached = pending_bytes;
+    }
+
+    const statistics& stats() const { return stats_; }
+
+private:
+    static constexpr size_t Min_block = 256;
+    static constexpr size_t Max_small_block = 1 << 20;        // 1 MiB
+    static constexpr size_t Large_granularity = 1 << 20;      // 1 MiB
+    static constexpr size_t Num_small_bins = 13;              // 2^8 ... 2^20
+
+    struct pending_free {
+        void* ptr;
+        size_t bytes;
+        sycl::event last_use;
+    };
+
+    static size_t round_up(size_t bytes) {
+        if (bytes <= Min_block) {
+            return Min_block;
+        }
+        if (bytes <= Max_small_block) {
+            size_t block = Min_block;
+            while (block < bytes) {
+                block <<= 1;
+            }
+            return block;
+        }
+        return (bytes + Large_granularity - 1) / Large_granularity * Large_granularity;
+    }
+
+    static size_t small_bin_index(size_t block_bytes) {
+        size_t index = 0;
+        for (size_t b = Min_block; b < block_bytes; b <<= 1) {
+            ++index;
+        }
+        return index;
+    }
+
+    // On a hit, block_bytes is updated to the size of the block actually returned
+    void* take_cached(size_t& block_bytes) {
+        if (block_bytes <= Max_small_block) {
+            auto& list = small_bins_[small_bin_index(block_bytes)];
+            if (list.empty()) {
+                return nullptr;
+            }
+            void* ptr = list.back();
+            list.pop_back();
+            return ptr;
+        }
+
+        auto it = large_blocks_.lower_bound(block_bytes);
+        if (it == large_blocks_.end() || it->first > 2 * block_bytes) {
+            return nullptr;
+        }
+        void* ptr = it->second;
+        block_bytes = it->first;
+        large_blocks_.erase(it);
+        return ptr;
+    }
+
+    size_t release_live(void* ptr) {
+        auto it = live_.find(ptr);
+        if (it == live_.end()) {
+            throw std::invalid_argument{"usm_device_pool: pointer was not allocated by this pool"};
+        }
+        const size_t block_bytes = it->second;
+        live_.erase(it);
+        stats_.bytes_in_use -= block_bytes;
+        stats_.bytes_cached += block_bytes;
+        return block_bytes;
+    }
+
+    // Move a block to the free lists (bytes_cached already accounts for it)
+    void park(void* ptr, size_t block_bytes) {
+        if (block_bytes <= Max_small_block) {
+            small_bins_[small_bin_index(block_bytes)].push_back(ptr);
+        } else {
+            large_blocks_.emplace(block_bytes, ptr);
+        }
+    }
+
+    void reclaim_completed() {
+        auto done = std::partition(pending_.begin(), pending_.end(), [](const pending_free& p) {
+            return p.last_use.get_info<sycl::info::event::command_execution_status>() !=
+                   sycl::info::event_command_status::complete;
+        });
+        for (auto it = done; it != pending_.end(); ++it) {
+            park(it->ptr, it->bytes);
+        }
+        pending_.erase(done, pending_.end());
+    }
+
+    sycl::queue& q_;
+    std::array<std::vector<void*>, Num_small_bins> small_bins_;
+    std::multimap<size_t, void*> large_blocks_;
+    std::unordered_map<void*, size_t> live_;
+    std::vector<pending_free> pending_;
+    statistics stats_;
+};
+
+// Benchmark
+//
+// Each iteration of a pattern allocates `buffers_per_iter` scratch arrays, fills them with a
+// kernel and releases them - the shape of a per-batch loop in production code.
+
+struct alloc_pattern {
+    std::string name;
+    std::vector<size_t> sizes; // bytes, one entry per allocation in the order requested
+    size_t buffers_per_iter;
+};
+
+sycl::event fill(sycl::queue& q, float* ptr, size_t count, float value) {
+    return q.parallel_for(sycl::range<1>{count}, [=](sycl::id<1> i) {
+        ptr[i] = value;
+    });
+}
+
+double run_raw(sycl::queue& q, const alloc_pattern& pattern) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    std::vector<float*> ptrs;
+    for (size_t i = 0; i < pattern.sizes.size(); i += pattern.buffers_per_iter) {
+        ptrs.clear();
+        for (size_t j = i; j < std::min(i + pattern.buffers_per_iter, pattern.sizes.size()); ++j) {
+            size_t count = pattern.sizes[j] / sizeof(float);
+            float* ptr = sycl::malloc_device<float>(count, q);
+            fill(q, ptr, count, 1.0f);
+            ptrs.push_back(ptr);
+        }
+        // sycl::free is not stream-ordered: kernels must finish first
+        q.wait();
+        for (float* ptr : ptrs) {
+            sycl::free(ptr, q);
+        }
+    }
+    auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+double run_pooled(sycl::queue& q, usm_device_pool& pool, const alloc_pattern& pattern) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < pattern.sizes.size(); i += pattern.buffers_per_iter) {
+        for (size_t j = i; j < std::min(i + pattern.buffers_per_iter, pattern.sizes.size()); ++j) {
+            size_t count = pattern.sizes[j] / sizeof(float);
+            float* ptr = pool.allocate<float>(count);
+            sycl::event ev = fill(q, ptr, count, 1.0f);
+            // Stream-ordered free: no wait, the block is reused once ev completes
+            pool.deallocate(ptr, ev);
+        }
+    }
+    q.wait();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+bool verify_pool(sycl::queue& q) {
+    usm_device_pool pool{q};
+    const size_t N = 1024 * 1024;
+    bool ok = true;
+
+    // Reuse the same block across iterations with a different value each time
+    for (int iter = 0; iter < 4; ++iter) {
+        float* a = pool.allocate<float>(N);
+        fill(q, a, N, static_cast<float>(iter));
+        std::vector<float> h(N);
+        sycl::event ev = q.memcpy(h.data(), a, N * sizeof(float));
+        ev.wait();
+        pool.deallocate(a, ev);
+        if (h[0] != static_cast<float>(iter) || h[N - 1] != static_cast<float>(iter)) {
+            ok = false;
+        }
+    }
+
+    // Every iteration after the first must have reused the cached block
+    if (pool.stats().device_mallocs != 1 || pool.stats().cache_hits != 3) {
+        ok = false;
+    }
+    return ok;
+}
+
+std::string format_bytes(size_t bytes) {
+    if (bytes >= (1u << 20)) {
+        return std::to_string(bytes >> 20) + " MiB";
+    }
+    if (bytes >= (1u << 10)) {
+        return std::to_string(bytes >> 10) + " KiB";
+    }
+    return std::to_string(bytes) + " B";
+}
+
+int main() {
+    sycl::queue q{sycl::default_selector_v, sycl::property_list{sycl::property::queue::in_order{}}};
+    std::cout << "Using device: " << q.get_device().get_info<sycl::info::device::name>() << std::endl;
+
+    if (!verify_pool(q)) {
+        std::cout << "USM pool allocator: FAILED" << std::endl;
+        return 1;
+    }
+    std::cout << "USM pool allocator: OK" << std::endl;
+
+    // Build allocation patterns
+    std::vector<alloc_pattern> patterns;
+    patterns.push_back({"small 4 KiB x3", std::vector<size_t>(3 * 1000, 4 * 1024), 3});
+    patterns.push_back({"small 64 KiB x3", std::vector<size_t>(3 * 500, 64 * 1024), 3});
+    patterns.push_back({"large 64 MiB x3", std::vector<size_t>(3 * 20, 64 * 1024 * 1024), 3});
+
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<size_t> small_dist{1, 256};   // x 1 KiB
+    std::uniform_int_distribution<size_t> large_dist{1, 32};    // x 1 MiB
+    std::vector<size_t> mixed;
+    for (int i = 0; i < 2000; ++i) {
+        size_t bytes = (i % 10 == 9) ? large_dist(rng) * 1024 * 1024 : small_dist(rng) * 1024;
+        mixed.push_back(bytes);
+    }
+    patterns.push_back({"mixed 1 KiB-32 MiB x4", mixed, 4});
+
+    // Warm up JIT for the fill kernel
+    {
+        float* warm = sycl::malloc_device<float>(1024, q);
+        fill(q, warm, 1024, 0.0f).wait();
+        sycl::free(warm, q);
+    }
+
+    std::cout << std::endl;
+    std::cout << std::left << std::setw(24) << "Pattern"
+              << std::right << std::setw(8) << "Allocs"
+              << std::setw(14) << "raw (ms)"
+              << std::setw(14) << "pool (ms)"
+              << std::setw(10) << "Speedup"
+              << std::setw(10) << "Mallocs"
+              << std::setw(10) << "Hits"
+              << std::setw(12) << "Peak" << std::endl;
+
+    for (const auto& pattern : patterns) {
+        double raw_ms = run_raw(q, pattern);
+
+        usm_device_pool pool{q};
+        double pool_ms = run_pooled(q, pool, pattern);
+        const auto& s = pool.stats();
+
+        std::cout << std::left << std::setw(24) << pattern.name
+                  << std::right << std::setw(8) << pattern.sizes.size()
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(14) << raw_ms
+                  << std::setw(14) << pool_ms
+                  << std::setw(9) << raw_ms / pool_ms << "x"
+                  << std::setw(10) << s.device_mallocs
+                  << std::setw(10) << s.cache_hits
+                  << std::setw(12) << format_bytes(s.peak_bytes_reserved) << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,226 @@
+#define ACPP_EXT_ACCESSOR_VARIANT_DEDUCTION
+#include <sycl/sycl.hpp>
+#define ACPP_EXT_EXPLICIT_BUFFER_POLICIES
+#include <hipSYCL/sycl/buffer_explicit_behavior.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Accessor variants under many kernel arguments
+//
+// A multi-field stencil reads 8 to 16 arrays per work-item. Every array is a kernel argument,
+// and with regular accessors every argument carries the pointer plus the buffer shape, access
+// offset and access range. The kernel has to pass all of it at launch and keep the parts it
+// uses in registers.
+//
+// With ACPP_EXT_ACCESSOR_VARIANT_DEDUCTION, an accessor constructed without an access range or
+// offset, as in sycl::accessor{buf, cgh, sycl::read_only}, deduces a smaller variant that only
+// stores what it can need. This benchmark runs the same 3-point stencil over F fields with
+//   regular  - buf.get_access<access_mode::read>(cgh), full ranged accessors (the output
+//              uses discard_write, the same semantics as the deduced write_only + no_init)
+//   deduced  - sycl::accessor{buf, cgh, sycl::read_only}, variant picked by deduction
+//   usm      - raw device pointers, the lower bound for argument size
+// and reports the kernel argument size and the throughput of each on every device.
+//
+// Usage: accessor_variants_benchmark [N]
+
+using clock_type = std::chrono::high_resolution_clock;
+
+// Field weights, the same on host and device
+inline float weight(size_t f) {
+    return 1.0f / static_cast<float>(f + 1);
+}
+
+// out[i] = sum_f w_f * (in_f[i - 1] + in_f[i] + in_f[i + 1]); in can be accessors or pointers
+template <size_t F, typename Inputs, typename Output>
+inline void stencil_point(const Inputs& in, const Output& out, size_t i) {
+    float sum = 0.0f;
+    for (size_t f = 0; f < F; ++f) {
+        sum += weight(f) * (in[f][i - 1] + in[f][i] + in[f][i + 1]);
+    }
+    out[i] = sum;
+}
+
+template <size_t... I>
+auto regular_accessors(std::vector<sycl::buffer<float, 1>>& bufs, sycl::handler& cgh, std::index_sequence<I...>) {
+    return std::array{bufs[I].template get_access<sycl::access_mode::read>(cgh)...};
+}
+
+template <size_t... I>
+auto deduced_accessors(std::vector<sycl::buffer<float, 1>>& bufs, sycl::handler& cgh, std::index_sequence<I...>) {
+    return std::array{sycl::accessor{bufs[I], cgh, sycl::read_only}...};
+}
+
+enum class variant { regular, deduced, usm };
+
+struct fields {
+    std::vector<sycl::buffer<float, 1>> in_bufs;
+    sycl::buffer<float, 1> out_buf;
+    std::vector<float*> in_ptrs;
+    float* out_ptr;
+};
+
+// One launch; arg_bytes receives the size of the captured kernel arguments
+template <size_t F>
+void launch(sycl::queue& q, variant v, fields& d, size_t N, size_t& arg_bytes) {
+    const sycl::range<1> interior{N - 2};
+    if (v == variant::usm) {
+        std::array<float*, F> in;
+        std::copy_n(d.in_ptrs.begin(), F, in.begin());
+        float* out = d.out_ptr;
+        arg_bytes = sizeof(in) + sizeof(out);
+        q.parallel_for(interior, [=](sycl::id<1> idx) { stencil_point<F>(in, out, idx[0] + 1); });
+        return;
+    }
+    q.submit([&](sycl::handler& cgh) {
+        if (v == variant::regular) {
+            auto in = regular_accessors(d.in_bufs, cgh, std::make_index_sequence<F>{});
+            // Same semantics as write_only + no_init in the deduced branch
+            auto out = d.out_buf.get_access<sycl::access_mode::discard_write>(cgh);
+            arg_bytes = sizeof(in) + sizeof(out);
+            cgh.parallel_for(interior, [=](sycl::id<1> idx) { stencil_point<F>(in, out, idx[0] + 1); });
+        } else {
+            auto in = deduced_accessors(d.in_bufs, cgh, std::make_index_sequence<F>{});
+            auto out = sycl::accessor{d.out_buf, cgh, sycl::write_only, sycl::no_init};
+            arg_bytes = sizeof(in) + sizeof(out);
+            cgh.parallel_for(interior, [=](sycl::id<1> idx) { stencil_point<F>(in, out, idx[0] + 1); });
+        }
+    });
+}
+
+// Average per-launch milliseconds after one warm-up launch (JIT, first-touch migration)
+template <size_t F>
+double time_variant(sycl::queue& q, variant v, fields& d, size_t N, size_t& arg_bytes) {
+    const int NUM_RUNS = 20;
+    launch<F>(q, v, d, N, arg_bytes);
+    q.wait();
+    auto t0 = clock_type::now();
+    for (int r = 0; r < NUM_RUNS; ++r) {
+        launch<F>(q, v, d, N, arg_bytes);
+    }
+    q.wait();
+    return std::chrono::duration<double, std::milli>(clock_type::now() - t0).count() / NUM_RUNS;
+}
+
+// Compares sampled interior points with a host reference
+template <size_t F>
+bool verify(const std::vector<float>& out, const std::vector<std::vector<float>>& host_in, size_t N) {
+    for (size_t i : {size_t{1}, N / 3, N / 2, N - 2}) {
+        float ref = 0.0f;
+        for (size_t f = 0; f < F; ++f) {
+            ref += weight(f) * (host_in[f][i - 1] + host_in[f][i] + host_in[f][i + 1]);
+        }
+        if (std::abs(out[i] - ref) > 1e-4f * std::max(1.0f, std::abs(ref))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <size_t F>
+bool run_fields(sycl::queue& q, fields& d, const std::vector<std::vector<float>>& host_in, size_t N) {
+    const char* names[] = {"regular", "deduced", "usm"};
+    const variant variants[] = {variant::regular, variant::deduced, variant::usm};
+    // F inputs and one output, each touched once per element
+    const double bytes = (F + 1.0) * N * sizeof(float);
+    bool ok = true;
+
+    std::vector<float> out(N);
+    for (int k = 0; k < 3; ++k) {
+        size_t arg_bytes = 0;
+        double ms = time_variant<F>(q, variants[k], d, N, arg_bytes);
+        if (variants[k] == variant::usm) {
+            q.memcpy(out.data(), d.out_ptr, N * sizeof(float)).wait();
+        } else {
+            sycl::host_accessor h{d.out_buf, sycl::read_only};
+            for (size_t i = 0; i < N; ++i) {
+                out[i] = h[i];
+            }
+        }
+        bool pass = verify<F>(out, host_in, N);
+        ok = ok && pass;
+        std::cout << std::setw(8) << F
+                  << std::setw(10) << names[k]
+                  << std::setw(12) << arg_bytes
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(12) << ms
+                  << std::setprecision(2)
+                  << std::setw(12) << bytes / (ms / 1000.0) / 1e9
+                  << std::setw(8) << (pass ? "OK" : "FAILED") << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+    }
+    return ok;
+}
+
+bool run_device(const sycl::device& dev, const std::vector<std::vector<float>>& host_in, size_t N) {
+    constexpr size_t MAX_FIELDS = 16;
+    sycl::queue q{dev, sycl::property_list{sycl::property::queue::in_order{}}};
+    std::cout << std::endl << "Device: " << dev.get_info<sycl::info::device::name>() << std::endl;
+    std::cout << std::setw(8) << "fields"
+              << std::setw(10) << "variant"
+              << std::setw(12) << "arg bytes"
+              << std::setw(12) << "ms"
+              << std::setw(12) << "GB/s"
+              << std::setw(8) << "check" << std::endl;
+
+    fields d{{}, sycl::make_sync_buffer<float>(sycl::range<1>{N}), {}, sycl::malloc_device<float>(N, q)};
+    for (size_t f = 0; f < MAX_FIELDS; ++f) {
+        d.in_bufs.push_back(sycl::make_sync_buffer(host_in[f].data(), sycl::range<1>{N}));
+        d.in_ptrs.push_back(sycl::malloc_device<float>(N, q));
+        q.memcpy(d.in_ptrs.back(), host_in[f].data(), N * sizeof(float));
+    }
+    q.wait();
+
+    bool ok = run_fields<8>(q, d, host_in, N);
+    ok = run_fields<12>(q, d, host_in, N) && ok;
+    ok = run_fields<16>(q, d, host_in, N) && ok;
+
+    for (float* p : d.in_ptrs) {
+        sycl::free(p, q);
+    }
+    sycl::free(d.out_ptr, q);
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    size_t N = 2 * 1024 * 1024;
+    if (argc > 1) {
+        try {
+            N = std::max<size_t>(std::stoull(argv[1]), 3);
+        } catch (const std::exception& e) {
+            std::cerr << "Error parsing N: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "3-point stencil over 8, 12 and 16 fields of " << N << " floats" << std::endl;
+
+    std::vector<std::vector<float>> host_in(16, std::vector<float>(N));
+    for (size_t f = 0; f < host_in.size(); ++f) {
+        for (size_t i = 0; i < N; ++i) {
+            host_in[f][i] = static_cast<float>((i + f) % 13) * 0.1f;
+        }
+    }
+
+    bool ok = true;
+    for (const auto& dev : sycl::device::get_devices()) {
+        try {
+            ok = run_device(dev, host_in, N) && ok;
+        } catch (const sycl::exception& e) {
+            std::cout << "Skipped: " << e.what() << std::endl;
+        }
+    }
+
+    // [!NOTE]: "arg bytes" is the size of the captured inputs and output, and the gap between
+    // regular and deduced grows with the field count. Whether it shows up in GB/s depends on
+    // the backend: compare the OpenMP host device with pocl and any GPU.
+
+    std::cout << std::endl << "Accessor variants benchmark: " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
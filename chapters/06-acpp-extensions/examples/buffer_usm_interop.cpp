@@ -0,0 +1,170 @@
+#define ACPP_EXT_BUFFER_USM_INTEROP
+#include <sycl/sycl.hpp>
+#define ACPP_EXT_EXPLICIT_BUFFER_POLICIES
+#include <hipSYCL/sycl/buffer_explicit_behavior.hpp>
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <vector>
+
+// Buffer-USM interop helpers
+//
+// Code bases that mix accessor-based kernels with pointer-based (USM) libraries need to hand the
+// same data back and forth. Copying on every handoff defeats the purpose; ACPP_EXT_BUFFER_USM_INTEROP
+// lets both sides share one device allocation instead.
+
+// Buffer -> USM: make the buffer's data current on q's device and return that allocation.
+// The read_write accessor marks the device copy as the only valid one, so anything the USM
+// code writes through the pointer is what later accessors see.
+template <class T, int Dim>
+T* acquire_device_pointer(sycl::queue& q, sycl::buffer<T, Dim>& buf) {
+    q.submit([&](sycl::handler& cgh) {
+        auto acc = buf.template get_access<sycl::access_mode::read_write>(cgh);
+        cgh.single_task([=]() {
+            (void)acc;
+        });
+    }).wait();
+    return buf.get_pointer(q.get_device());
+}
+
+// USM -> buffer. The data state hint decides whether the runtime may read the allocation:
+//   current       - the allocation holds valid data (buffer_allocation::view)
+//   uninitialized - the allocation is scratch space (buffer_allocation::empty_view)
+// Picking the wrong one either loses data or triggers a migration (see Chapter 08, #16).
+enum class data_state { current, uninitialized };
+
+template <class T>
+sycl::buffer<T, 1> wrap_device_pointer(T* usm_ptr, size_t n, const sycl::device& dev, data_state state) {
+    if (state == data_state::current) {
+        // Factory shortcut for buffer_allocation::view on a device USM pointer. Without dev the
+        // allocation would be bound to the default device, whatever device it came from.
+        return sycl::make_async_usm_view(usm_ptr, sycl::range<1>{n}, dev);
+    }
+    return sycl::buffer<T, 1>{{sycl::buffer_allocation::empty_view(usm_ptr, dev)}, sycl::range<1>{n}};
+}
+
+// Accessor-based kernel: x = x * 2 + 1
+void scale_with_accessor(sycl::queue& q, sycl::buffer<float, 1>& buf) {
+    q.submit([&](sycl::handler& cgh) {
+        auto acc = buf.get_access<sycl::access_mode::read_write>(cgh);
+        cgh.parallel_for<class AccessorScaleKernel>(buf.get_range(), [=](sycl::id<1> i) {
+            acc[i] = acc[i] * 2.0f + 1.0f;
+        });
+    });
+}
+
+// Pointer-based kernel, standing in for a USM library call: x = x - 0.5
+void shift_with_pointer(sycl::queue& q, float* ptr, size_t n) {
+    q.parallel_for<class PointerShiftKernel>(sycl::range<1>{n}, [=](sycl::id<1> i) {
+        ptr[i] = ptr[i] - 0.5f;
+    });
+}
+
+int main() {
+    const size_t N = 64 * 1024 * 1024; // 256 MiB of floats: a hidden copy would be obvious
+    const int HANDOFFS = 20;
+    sycl::queue q{sycl::default_selector_v, sycl::property_list{sycl::property::queue::in_order{}}};
+    auto dev = q.get_device();
+    std::cout << "Using device: " << dev.get_info<sycl::info::device::name>() << std::endl;
+
+    float* d_data = sycl::malloc_device<float>(N, q);
+    float* d_scratch = sycl::malloc_device<float>(N, q);
+    bool ok = true;
+
+    // Check 1 - wrapping a USM allocation reuses it: the buffer's device allocation is d_data
+    {
+        q.fill(d_data, 1.0f, N).wait();
+        auto buf = wrap_device_pointer(d_data, N, dev, data_state::current);
+        scale_with_accessor(q, buf);
+        float* extracted = acquire_device_pointer(q, buf);
+
+        float first = 0.0f;
+        q.memcpy(&first, d_data, sizeof(float)).wait();
+        bool pass = extracted == d_data && first == 3.0f;
+        std::cout << "USM -> buffer -> USM keeps the allocation: " << (pass ? "OK" : "FAILED") << std::endl;
+        ok = ok && pass;
+    }
+
+    // Check 2 - empty_view: the runtime must not read the allocation, only write it
+    {
+        auto buf = wrap_device_pointer(d_scratch, N, dev, data_state::uninitialized);
+        q.submit([&](sycl::handler& cgh) {
+            auto acc = buf.get_access<sycl::access_mode::discard_write>(cgh);
+            cgh.parallel_for<class ScratchInitKernel>(sycl::range<1>{N}, [=](sycl::id<1> i) {
+                acc[i] = 5.0f;
+            });
+        });
+        float* extracted = acquire_device_pointer(q, buf);
+
+        float last = 0.0f;
+        q.memcpy(&last, d_scratch + N - 1, sizeof(float)).wait();
+        bool pass = extracted == d_scratch && last == 5.0f;
+        std::cout << "empty_view scratch buffer: " << (pass ? "OK" : "FAILED") << std::endl;
+        ok = ok && pass;
+    }
+
+    // Check 3 - repeated handoffs cost no migrations.
+    // Reference: one device-to-device copy of N floats, i.e. the cost of one hidden migration.
+    q.memcpy(d_scratch, d_data, N * sizeof(float)).wait();
+    auto c0 = std::chrono::high_resolution_clock::now();
+    q.memcpy(d_scratch, d_data, N * sizeof(float)).wait();
+    auto c1 = std::chrono::high_resolution_clock::now();
+    double copy_ms = std::chrono::duration<double, std::milli>(c1 - c0).count();
+
+    // Baseline: the same two kernels per iteration, both on the raw pointer
+    q.fill(d_data, 0.0f, N).wait();
+    auto b0 = std::chrono::high_resolution_clock::now();
+    for (int h = 0; h < HANDOFFS; ++h) {
+        q.parallel_for<class BaselineScaleKernel>(sycl::range<1>{N}, [=](sycl::id<1> i) {
+            d_data[i] = d_data[i] * 2.0f + 1.0f;
+        });
+        shift_with_pointer(q, d_data, N);
+    }
+    q.wait();
+    auto b1 = std::chrono::high_resolution_clock::now();
+    double baseline_ms = std::chrono::duration<double, std::milli>(b1 - b0).count();
+
+    // Interop: alternate accessor kernel and pointer kernel on the same data
+    q.fill(d_data, 0.0f, N).wait();
+    std::set<float*> distinct_allocations; // allocation counter: every handoff must see d_data
+    auto i0 = std::chrono::high_resolution_clock::now();
+    {
+        auto buf = wrap_device_pointer(d_data, N, dev, data_state::current);
+        for (int h = 0; h < HANDOFFS; ++h) {
+            scale_with_accessor(q, buf);
+            float* ptr = acquire_device_pointer(q, buf);
+            distinct_allocations.insert(ptr);
+            shift_with_pointer(q, ptr, N);
+        }
+        q.wait();
+    }
+    auto i1 = std::chrono::high_resolution_clock::now();
+    double interop_ms = std::chrono::duration<double, std::milli>(i1 - i0).count();
+
+    // Every handoff must see the other side's result: x -> 2x + 1 -> 2x + 0.5
+    float expected = 0.0f;
+    for (int h = 0; h < HANDOFFS; ++h) {
+        expected = expected * 2.0f + 1.0f;
+        expected = expected - 0.5f;
+    }
+    std::vector<float> h(N);
+    q.memcpy(h.data(), d_data, N * sizeof(float)).wait();
+    bool values_ok = h[0] == expected && h[N / 2] == expected && h[N - 1] == expected;
+
+    double overhead_ms = (interop_ms - baseline_ms) / HANDOFFS;
+    std::cout << "One " << (N * sizeof(float) >> 20) << " MiB copy: " << copy_ms << " ms" << std::endl;
+    std::cout << "Baseline: " << baseline_ms << " ms, interop: " << interop_ms << " ms, "
+              << "overhead per handoff: " << overhead_ms << " ms" << std::endl;
+    std::cout << "Distinct device allocations seen: " << distinct_allocations.size() << std::endl;
+
+    // A hidden migration per handoff would cost at least one copy_ms each
+    bool pass = values_ok && distinct_allocations.size() == 1 &&
+                *distinct_allocations.begin() == d_data && overhead_ms < 0.5 * copy_ms;
+    std::cout << "No hidden migrations: " << (pass ? "OK" : "FAILED") << std::endl;
+    ok = ok && pass;
+
+    sycl::free(d_data, q);
+    sycl::free(d_scratch, q);
+
+    return ok ? 0 : 1;
+}
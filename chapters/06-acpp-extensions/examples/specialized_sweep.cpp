@@ -0,0 +1,229 @@
+#include <sycl/sycl.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// When does sycl::specialized<T> pay off?
+//
+// A specialized value is baked into the kernel as a constant when the kernel is JIT-compiled,
+// so every distinct value is a distinct kernel binary: the first launch with a new value pays
+// a JIT compile, and the binary is added to the kernel cache. Launches that reuse a value run
+// the specialized binary, which can be faster than passing the value as a plain argument
+// (constant trip counts unroll, constant multipliers fold).
+//
+// This benchmark measures both sides:
+//   sweep - num_values distinct scales, timing the first launch (JIT) against the second
+//           one, and the growth of the on-disk kernel cache
+//   reuse - many launches cycling over a few already-compiled values, specialized versus
+//           the same kernel with plain arguments
+// and prints the number of launches per distinct value needed to win back one recompile.
+//
+// Usage: specialized_sweep [num_values] [launches]
+
+using clock_type = std::chrono::high_resolution_clock;
+
+constexpr int ITERS = 64; // FMA chain length per element
+
+double elapsed_ms(clock_type::time_point t0) {
+    return std::chrono::duration<double, std::milli>(clock_type::now() - t0).count();
+}
+
+// Same loop for both variants: only the type of scale and iters differs
+template <typename Scale, typename Iters>
+void launch(sycl::queue& q, const float* in, float* out, size_t N, Scale scale, Iters iters) {
+    q.parallel_for(sycl::range<1>{N}, [=](sycl::id<1> i) {
+        const float s = scale;
+        const int n = iters;
+        float x = in[i];
+        for (int k = 0; k < n; ++k) {
+            x = sycl::fma(x, s, 1.0f);
+        }
+        out[i] = x;
+    });
+}
+
+void launch_specialized(sycl::queue& q, const float* in, float* out, size_t N, float scale) {
+    sycl::specialized<float> s_scale{scale};
+    sycl::specialized<int> s_iters{ITERS};
+    launch(q, in, out, N, s_scale, s_iters);
+}
+
+void launch_plain(sycl::queue& q, const float* in, float* out, size_t N, float scale) {
+    launch(q, in, out, N, scale, ITERS);
+}
+
+// The application database holds the persistent kernel cache
+std::filesystem::path appdb_dir() {
+    if (const char* dir = std::getenv("ACPP_APPDB_DIR")) {
+        return dir;
+    }
+    const char* home = std::getenv("HOME");
+    return std::filesystem::path{home ? home : "."} / ".acpp" / "apps";
+}
+
+struct dir_usage {
+    size_t files = 0;
+    uintmax_t bytes = 0;
+};
+
+dir_usage measure_dir(const std::filesystem::path& dir) {
+    dir_usage u;
+    std::error_code ec;
+    if (!std::filesystem::exists(dir, ec)) {
+        return u;
+    }
+    for (auto it = std::filesystem::recursive_directory_iterator{dir, ec};
+         !ec && it != std::filesystem::recursive_directory_iterator{}; it.increment(ec)) {
+        if (it->is_regular_file(ec)) {
+            ++u.files;
+            u.bytes += it->file_size(ec);
+        }
+    }
+    return u;
+}
+
+float scale_for(int v) {
+    return 1.0f + static_cast<float>(v) / 1024.0f;
+}
+
+bool verify(sycl::queue& q, const float* d_out, size_t N, float scale) {
+    std::vector<float> out(N);
+    q.memcpy(out.data(), d_out, N * sizeof(float)).wait();
+    for (size_t i : {size_t{0}, N / 2, N - 1}) {
+        float x = static_cast<float>(i % 100) * 0.01f;
+        for (int k = 0; k < ITERS; ++k) {
+            x = std::fma(x, scale, 1.0f);
+        }
+        if (std::abs(out[i] - x) > 1e-5f * std::abs(x)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int num_values = 64;
+    int launches = 400;
+    if (argc > 1) {
+        try {
+            num_values = std::stoi(argv[1]);
+            if (argc > 2) {
+                launches = std::stoi(argv[2]);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error parsing arguments: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    num_values = std::max(num_values, 1);
+    launches = std::max(launches, 1);
+
+    const size_t N = 1024 * 1024;
+    sycl::queue q{sycl::default_selector_v, sycl::property_list{sycl::property::queue::in_order{}}};
+    std::cout << "Using device: " << q.get_device().get_info<sycl::info::device::name>() << std::endl;
+
+    float* d_in = sycl::malloc_device<float>(N, q);
+    float* d_out = sycl::malloc_device<float>(N, q);
+    q.parallel_for(sycl::range<1>{N}, [=](sycl::id<1> i) { d_in[i] = static_cast<float>(i[0] % 100) * 0.01f; });
+    q.wait();
+
+    bool ok = true;
+
+    // The plain kernel is compiled once, whatever the scale
+    launch_plain(q, d_in, d_out, N, scale_for(0));
+    q.wait();
+    ok = ok && verify(q, d_out, N, scale_for(0));
+
+    // ---- Sweep: every distinct value costs one JIT compile -----------------------------------
+    const std::filesystem::path cache = appdb_dir();
+    dir_usage before = measure_dir(cache);
+
+    std::vector<double> recompile_ms;
+    for (int v = 0; v < num_values; ++v) {
+        auto t0 = clock_type::now();
+        launch_specialized(q, d_in, d_out, N, scale_for(v));
+        q.wait();
+        double first_ms = elapsed_ms(t0);
+
+        t0 = clock_type::now();
+        launch_specialized(q, d_in, d_out, N, scale_for(v));
+        q.wait();
+        double second_ms = elapsed_ms(t0);
+
+        recompile_ms.push_back(std::max(0.0, first_ms - second_ms));
+        if (v == 0 || v == num_values - 1) {
+            ok = ok && verify(q, d_out, N, scale_for(v));
+        }
+    }
+
+    dir_usage after = measure_dir(cache);
+    std::sort(recompile_ms.begin(), recompile_ms.end());
+    double total_recompile = 0.0;
+    for (double t : recompile_ms) {
+        total_recompile += t;
+    }
+    double mean_recompile = total_recompile / num_values;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << std::endl << "Sweep over " << num_values << " distinct specialized values" << std::endl;
+    std::cout << "  recompile latency: median " << recompile_ms[recompile_ms.size() / 2] << " ms, mean "
+              << mean_recompile << " ms, max " << recompile_ms.back() << " ms, total " << total_recompile
+              << " ms" << std::endl;
+    std::cout << "  kernel cache " << cache.string() << ": +" << (after.files - std::min(after.files, before.files))
+              << " files, +" << (after.bytes - std::min(after.bytes, before.bytes)) / 1024.0 << " KiB ("
+              << after.files << " files, " << after.bytes / 1024.0 << " KiB total)" << std::endl;
+
+    // ---- Reuse: launches cycling over already-compiled values ---------------------------------
+    const int reused_values = std::min(num_values, 4);
+    auto t0 = clock_type::now();
+    for (int l = 0; l < launches; ++l) {
+        launch_plain(q, d_in, d_out, N, scale_for(l % reused_values));
+    }
+    q.wait();
+    double plain_ms = elapsed_ms(t0) / launches;
+
+    t0 = clock_type::now();
+    for (int l = 0; l < launches; ++l) {
+        launch_specialized(q, d_in, d_out, N, scale_for(l % reused_values));
+    }
+    q.wait();
+    double specialized_ms = elapsed_ms(t0) / launches;
+    ok = ok && verify(q, d_out, N, scale_for((launches - 1) % reused_values));
+
+    // 1 FMA = 2 FLOPs
+    double flops = 2.0 * ITERS * N;
+    std::cout << std::endl << "Reuse: " << launches << " launches cycling over " << reused_values << " values" << std::endl;
+    std::cout << std::setw(14) << "variant" << std::setw(16) << "ms/launch" << std::setw(12) << "GFLOP/s" << std::endl;
+    std::cout << std::setw(14) << "plain" << std::setw(16) << plain_ms << std::setw(12) << flops / (plain_ms / 1000.0) / 1e9
+              << std::endl;
+    std::cout << std::setw(14) << "specialized" << std::setw(16) << specialized_ms << std::setw(12)
+              << flops / (specialized_ms / 1000.0) / 1e9 << std::endl;
+
+    // Launches per distinct value needed before specializing beats the plain kernel
+    double gain_ms = plain_ms - specialized_ms;
+    std::cout << std::endl << "Speedup when reused: " << std::setprecision(2) << plain_ms / specialized_ms << "x" << std::endl;
+    if (gain_ms > 0.0) {
+        std::cout << "Break-even: " << std::setprecision(0) << std::ceil(mean_recompile / gain_ms)
+                  << " launches per distinct value" << std::endl;
+    } else {
+        std::cout << "Break-even: never, the specialized kernel is not faster on this device" << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+
+    sycl::free(d_in, q);
+    sycl::free(d_out, q);
+
+    // [!NOTE]: Run the benchmark twice. On the second run the values are already in the
+    // persistent kernel cache, so the "recompile" latency drops to the cost of loading a
+    // cached binary and the cache no longer grows.
+
+    std::cout << "Specialized sweep: " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
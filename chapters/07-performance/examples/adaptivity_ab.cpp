@@ -0,0 +1,431 @@
+#include <sycl/sycl.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+// ACPP_ADAPTIVITY_LEVEL A/B runner
+//
+// The adaptivity level is read once when the runtime starts, so comparing levels takes one
+// process per level. This program re-executes itself as a worker with ACPP_ADAPTIVITY_LEVEL
+// set, several runs per level. All runs of a level share one kernel cache (ACPP_APPDB_DIR in a
+// temporary directory) that starts empty, so the first run is cold and later runs see what
+// earlier ones left in the cache, as repeated runs of a real application do. The worker
+// launches one kernel hundreds of times, timing each launch on its own. The driver then
+// reports, per level and run:
+//
+//   first launch  - includes the initial JIT compile
+//   steady state  - median of the last quarter of the launches
+//   converged at  - first launch after which the rolling median stays within 10% of steady
+//   re-JIT spikes - later launches slower than 3x steady state: the runtime recompiling the
+//                   kernel with the invariant arguments it has detected
+//
+// and writes the per-launch times of all levels to adaptivity_<kernel>.svg, the runs of a level
+// one after another.
+//
+// Usage: adaptivity_ab [vadd|jacobi|matmul] [launches] [levels, e.g. 0,1,2] [runs per level]
+
+using clock_type = std::chrono::high_resolution_clock;
+
+// ---- Worker: one kernel, many launches, one line per launch ---------------------------------
+
+// Sizes are runtime values on purpose: invariant kernel arguments are what adaptivity level 2
+// detects and specializes.
+int run_worker(const std::string& kernel, int launches) {
+    sycl::queue q{sycl::default_selector_v, sycl::property_list{sycl::property::queue::in_order{}}};
+    std::cout << "device " << q.get_device().get_info<sycl::info::device::name>() << std::endl;
+
+    size_t n = 1 << 22;
+    size_t M = 512;
+    const size_t TILE = 16;
+    if (kernel == "matmul") {
+        n = M * M;
+    }
+    float* x = sycl::malloc_device<float>(n, q);
+    float* y = sycl::malloc_device<float>(n, q);
+    float* z = sycl::malloc_device<float>(n, q);
+    q.fill(x, 1.0f, n);
+    q.fill(y, 2.0f, n).wait();
+
+    auto launch = [&]() {
+        if (kernel == "vadd") {
+            q.parallel_for<class AdaptVectorAdd>(sycl::range<1>{n}, [=](sycl::id<1> i) { z[i] = x[i] + y[i]; });
+        } else if (kernel == "jacobi") {
+            q.parallel_for<class AdaptJacobiStep>(sycl::range<1>{n}, [=](sycl::id<1> idx) {
+                size_t i = idx[0];
+                float v = 1.0f;
+                if (i > 0) {
+                    v += x[i - 1];
+                }
+                if (i < n - 1) {
+                    v += x[i + 1];
+                }
+                z[i] = v / 4.0f;
+            });
+        } else {
+            q.submit([&](sycl::handler& cgh) {
+                sycl::local_accessor<float, 1> a_tile{TILE * TILE, cgh};
+                sycl::local_accessor<float, 1> b_tile{TILE * TILE, cgh};
+                sycl::nd_range<2> range{sycl::range<2>{M, M}, sycl::range<2>{TILE, TILE}};
+                cgh.parallel_for<class AdaptMatMul>(range, [=](sycl::nd_item<2> item) {
+                    size_t row = item.get_global_id(0);
+                    size_t col = item.get_global_id(1);
+                    size_t lr = item.get_local_id(0);
+                    size_t lc = item.get_local_id(1);
+                    float acc = 0.0f;
+                    for (size_t k0 = 0; k0 < M; k0 += TILE) {
+                        a_tile[lr * TILE + lc] = x[row * M + k0 + lc];
+                        b_tile[lr * TILE + lc] = y[(k0 + lr) * M + col];
+                        sycl::group_barrier(item.get_group());
+                        for (size_t k = 0; k < TILE; ++k) {
+                            acc += a_tile[lr * TILE + k] * b_tile[k * TILE + lc];
+                        }
+                        sycl::group_barrier(item.get_group());
+                    }
+                    z[row * M + col] = acc;
+                });
+            });
+        }
+    };
+
+    for (int l = 0; l < launches; ++l) {
+        auto t0 = clock_type::now();
+        launch();
+        q.wait();
+        std::cout << l << " " << std::chrono::duration<double, std::milli>(clock_type::now() - t0).count() << "\n";
+    }
+
+    float check = 0.0f;
+    q.memcpy(&check, z + n / 2, sizeof(float)).wait();
+    float expected = kernel == "vadd" ? 3.0f : kernel == "jacobi" ? 0.75f : 2.0f * M;
+    sycl::free(x, q);
+    sycl::free(y, q);
+    sycl::free(z, q);
+    std::cout << "check " << (check == expected ? "OK" : "FAILED") << std::endl;
+    return check == expected ? 0 : 1;
+}
+
+// ---- Driver: one worker process per level and run -------------------------------------------
+
+struct level_run {
+    int level;
+    int run = 1; // 1-based; runs of a level share the kernel cache
+    std::string device;
+    std::vector<double> ms;
+    bool ok = false;
+    double first_ms = 0.0;
+    double steady_ms = 0.0;
+    int converged_at = -1;
+    std::vector<int> spikes;
+};
+
+double median(std::vector<double> v) {
+    std::sort(v.begin(), v.end());
+    return v.empty() ? 0.0 : v[v.size() / 2];
+}
+
+void analyze(level_run& r) {
+    const size_t n = r.ms.size();
+    r.first_ms = r.ms.front();
+    r.steady_ms = median(std::vector<double>(r.ms.begin() + n * 3 / 4, r.ms.end()));
+
+    // Rolling median over 8 launches: converged once it stays within 10% of steady state
+    const size_t W = 8;
+    r.converged_at = static_cast<int>(n);
+    for (size_t end = n; end >= W; --end) {
+        double m = median(std::vector<double>(r.ms.begin() + (end - W), r.ms.begin() + end));
+        if (std::abs(m - r.steady_ms) > 0.1 * r.steady_ms) {
+            break;
+        }
+        r.converged_at = static_cast<int>(end - W);
+    }
+    for (size_t l = 1; l < n; ++l) {
+        if (r.ms[l] > 3.0 * r.steady_ms) {
+            r.spikes.push_back(static_cast<int>(l));
+        }
+    }
+}
+
+// Starts "self --worker kernel launches" with the given level and kernel cache, stdout piped
+// back. The environment is passed to execve directly, so no shell parses the paths.
+FILE* start_worker(const std::string& self, const std::string& kernel, int launches, int level,
+                   const std::filesystem::path& appdb, pid_t& pid) {
+    std::vector<std::string> env_strings = {"ACPP_ADAPTIVITY_LEVEL=" + std::to_string(level),
+                                            "ACPP_APPDB_DIR=" + appdb.string()};
+    for (char** e = environ; *e; ++e) {
+        std::string var{*e};
+        if (var.rfind("ACPP_ADAPTIVITY_LEVEL=", 0) != 0 && var.rfind("ACPP_APPDB_DIR=", 0) != 0) {
+            env_strings.push_back(var);
+        }
+    }
+    std::vector<std::string> arg_strings = {self, "--worker", kernel, std::to_string(launches)};
+    std::vector<char*> envp, argv;
+    for (auto& e : env_strings) {
+        envp.push_back(e.data());
+    }
+    envp.push_back(nullptr);
+    for (auto& a : arg_strings) {
+        argv.push_back(a.data());
+    }
+    argv.push_back(nullptr);
+
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        return nullptr;
+    }
+    pid = ::fork();
+    if (pid < 0) {
+        ::close(fds[0]);
+        ::close(fds[1]);
+        return nullptr;
+    }
+    if (pid == 0) {
+        ::dup2(fds[1], STDOUT_FILENO);
+        ::close(fds[0]);
+        ::close(fds[1]);
+        ::execve(self.c_str(), argv.data(), envp.data());
+        ::_exit(127);
+    }
+    ::close(fds[1]);
+    return ::fdopen(fds[0], "r");
+}
+
+level_run run_level(const std::string& self, const std::string& kernel, int launches, int level, int run,
+                    const std::filesystem::path& appdb) {
+    level_run r;
+    r.level = level;
+    r.run = run;
+
+    pid_t pid = -1;
+    FILE* pipe = start_worker(self, kernel, launches, level, appdb, pid);
+    if (!pipe) {
+        return r;
+    }
+    char line[512];
+    bool check_ok = false;
+    while (std::fgets(line, sizeof(line), pipe)) {
+        std::string s{line};
+        if (s.rfind("device ", 0) == 0) {
+            r.device = s.substr(7, s.find_last_not_of("\r\n") - 6);
+        } else if (s.rfind("check ", 0) == 0) {
+            check_ok = s.find("OK") != std::string::npos;
+        } else {
+            std::istringstream in{s};
+            int l = 0;
+            double ms = 0.0;
+            if (in >> l >> ms) {
+                r.ms.push_back(ms);
+            }
+        }
+    }
+    std::fclose(pipe);
+    int status = 0;
+    pid_t waited = ::waitpid(pid, &status, 0);
+
+    r.ok = check_ok && waited == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0 &&
+           static_cast<int>(r.ms.size()) == launches;
+    if (!r.ms.empty()) {
+        analyze(r);
+    }
+    return r;
+}
+
+// Per-launch times, log y axis, one polyline per level with its runs placed one after another
+void write_svg(const std::string& path, const std::string& title, const std::vector<level_run>& runs,
+               size_t launches, int runs_per_level) {
+    const double W = 720, H = 480, L = 70, R = 110, T = 40, B = 50;
+    double lo = 1e30, hi = 0.0;
+    for (const auto& r : runs) {
+        for (double ms : r.ms) {
+            lo = std::min(lo, ms);
+            hi = std::max(hi, ms);
+        }
+    }
+    const size_t total = launches * runs_per_level;
+    const double y_min = std::pow(10.0, std::floor(std::log10(std::max(lo, 1e-4))));
+    const double y_max = std::pow(10.0, std::ceil(std::log10(std::max(hi, y_min * 10))));
+    auto px = [&](double l) { return L + (W - L - R) * l / std::max<double>(1.0, total - 1); };
+    auto py = [&](double ms) {
+        ms = std::max(ms, y_min);
+        return H - B - (H - T - B) * std::log(ms / y_min) / std::log(y_max / y_min);
+    };
+
+    std::ofstream out{path};
+    out << std::fixed << std::setprecision(1);
+    out << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << W << "\" height=\"" << H
+        << "\" font-family=\"sans-serif\" font-size=\"12\">\n";
+    out << "<rect width=\"100%\" height=\"100%\" fill=\"white\"/>\n";
+    out << "<text x=\"" << W / 2 << "\" y=\"24\" text-anchor=\"middle\" font-size=\"14\">" << title << "</text>\n";
+
+    for (double ms = y_min; ms <= y_max * 1.001; ms *= 10) {
+        out << "<line x1=\"" << L << "\" y1=\"" << py(ms) << "\" x2=\"" << W - R << "\" y2=\"" << py(ms)
+            << "\" stroke=\"#ddd\"/>\n";
+        out << "<text x=\"" << L - 6 << "\" y=\"" << py(ms) + 4 << "\" text-anchor=\"end\">" << ms << "</text>\n";
+    }
+    // Run boundaries: dashed line and run number; launch numbers restart in every run
+    for (int run = 0; run < runs_per_level; ++run) {
+        const double x = px(static_cast<double>(run * launches));
+        if (run > 0) {
+            out << "<line x1=\"" << x << "\" y1=\"" << T << "\" x2=\"" << x << "\" y2=\"" << H - B
+                << "\" stroke=\"#999\" stroke-dasharray=\"4 3\"/>\n";
+        }
+        out << "<text x=\"" << x + 4 << "\" y=\"" << T + 12 << "\" fill=\"#666\">run " << run + 1 << "</text>\n";
+    }
+    const size_t step = total <= 100 ? 10 : total <= 500 ? 50 : total <= 2000 ? 250 : 500;
+    for (size_t l = 0; l < total; l += step) {
+        out << "<text x=\"" << px(l) << "\" y=\"" << H - B + 16 << "\" text-anchor=\"middle\">" << l % launches
+            << "</text>\n";
+    }
+    out << "<text x=\"" << (L + W - R) / 2 << "\" y=\"" << H - 12 << "\" text-anchor=\"middle\">Launch (per run)</text>\n";
+    out << "<text x=\"16\" y=\"" << (T + H - B) / 2 << "\" text-anchor=\"middle\" transform=\"rotate(-90 16 "
+        << (T + H - B) / 2 << ")\">ms per launch</text>\n";
+
+    const char* colors[] = {"#1f77b4", "#d62728", "#2ca02c", "#9467bd", "#ff7f0e", "#8c564b"};
+    std::vector<int> levels;
+    for (const auto& r : runs) {
+        if (std::find(levels.begin(), levels.end(), r.level) == levels.end()) {
+            levels.push_back(r.level);
+        }
+    }
+    for (size_t k = 0; k < levels.size(); ++k) {
+        const char* color = colors[k % 6];
+        out << "<polyline fill=\"none\" stroke=\"" << color << "\" stroke-width=\"1.5\" points=\"";
+        for (const auto& r : runs) {
+            if (r.level != levels[k]) {
+                continue;
+            }
+            for (size_t l = 0; l < r.ms.size(); ++l) {
+                out << px(static_cast<double>((r.run - 1) * launches + l)) << "," << py(r.ms[l]) << " ";
+            }
+        }
+        out << "\"/>\n";
+        out << "<text x=\"" << W - R + 10 << "\" y=\"" << T + 20 + 18 * k << "\" fill=\"" << color << "\">level "
+            << levels[k] << "</text>\n";
+    }
+    out << "</svg>\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string{argv[1]} == "--worker") {
+        if (argc < 4) {
+            return 1;
+        }
+        return run_worker(argv[2], std::atoi(argv[3]));
+    }
+
+    std::string kernel = argc > 1 ? argv[1] : "matmul";
+    int launches = 300;
+    std::vector<int> levels = {0, 1, 2};
+    int runs_per_level = 4;
+    try {
+        if (argc > 2) {
+            launches = std::max(std::stoi(argv[2]), 8);
+        }
+        if (argc > 3) {
+            levels.clear();
+            std::stringstream ss{argv[3]};
+            std::string item;
+            while (std::getline(ss, item, ',')) {
+                levels.push_back(std::stoi(item));
+            }
+        }
+        if (argc > 4) {
+            runs_per_level = std::max(std::stoi(argv[4]), 1);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error parsing arguments: " << e.what() << std::endl;
+        return 1;
+    }
+    if (levels.empty()) {
+        std::cerr << "Error: no adaptivity levels given, e.g. 0,1,2" << std::endl;
+        return 1;
+    }
+    if (kernel != "vadd" && kernel != "jacobi" && kernel != "matmul") {
+        std::cerr << "Usage: adaptivity_ab [vadd|jacobi|matmul] [launches] [levels, e.g. 0,1,2] [runs per level]"
+                  << std::endl;
+        return 1;
+    }
+
+    const std::string self = std::filesystem::read_symlink("/proc/self/exe").string();
+    std::vector<level_run> runs;
+    bool ok = true;
+    for (int level : levels) {
+        // One kernel cache per level, empty before run 1 and kept across its runs
+        std::filesystem::path appdb = std::filesystem::temp_directory_path() /
+                                      ("acpp_adaptivity_" + std::to_string(getpid()) + "_" + std::to_string(level));
+        std::filesystem::remove_all(appdb);
+        std::filesystem::create_directories(appdb);
+        for (int run = 1; run <= runs_per_level; ++run) {
+            std::cout << "Running " << kernel << " " << launches << " times at ACPP_ADAPTIVITY_LEVEL=" << level
+                      << ", run " << run << "/" << runs_per_level << "..." << std::endl;
+            runs.push_back(run_level(self, kernel, launches, level, run, appdb));
+            ok = ok && runs.back().ok;
+        }
+        std::filesystem::remove_all(appdb);
+    }
+    if (!runs.empty() && !runs.front().device.empty()) {
+        std::cout << "Device: " << runs.front().device << std::endl;
+    }
+
+    std::cout << std::endl
+              << std::setw(6) << "level"
+              << std::setw(5) << "run"
+              << std::setw(12) << "first ms"
+              << std::setw(12) << "steady ms"
+              << std::setw(14) << "converged at"
+              << std::setw(10) << "re-JITs"
+              << std::setw(15) << "vs level " + std::to_string(levels.front())
+              << std::setw(8) << "check" << std::endl;
+    for (const auto& r : runs) {
+        std::ostringstream spikes;
+        for (size_t s = 0; s < r.spikes.size() && s < 3; ++s) {
+            spikes << (s ? "," : " (") << r.spikes[s];
+        }
+        if (!r.spikes.empty()) {
+            spikes << (r.spikes.size() > 3 ? ",...)" : ")");
+        }
+        // Against the same run of the first level
+        double base_ms = 0.0;
+        for (const auto& b : runs) {
+            if (b.level == levels.front() && b.run == r.run) {
+                base_ms = b.steady_ms;
+            }
+        }
+        double gain = r.steady_ms > 0.0 ? base_ms / r.steady_ms : 0.0;
+        std::cout << std::setw(6) << r.level
+                  << std::setw(5) << r.run
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(12) << r.first_ms
+                  << std::setw(12) << r.steady_ms
+                  << std::setw(14) << r.converged_at
+                  << std::setw(10) << r.spikes.size()
+                  << std::setprecision(2)
+                  << std::setw(14) << gain << "x"
+                  << std::setw(8) << (r.ok ? "OK" : "FAILED")
+                  << spikes.str() << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+    }
+
+    std::string svg = "adaptivity_" + kernel + ".svg";
+    write_svg(svg, "Per-launch time: " + kernel, runs, static_cast<size_t>(launches), runs_per_level);
+    std::cout << std::endl << "Plot written to " << svg << std::endl;
+
+    // [!NOTE]: Each level starts with an empty kernel cache, so "first ms" of run 1 always
+    // includes the JIT. At level 2, later runs start from what earlier runs stored in the
+    // cache: re-JIT spikes that move to earlier launches or disappear, and a falling "first ms",
+    // are the convergence across runs. The steady-state gain is what specialization buys.
+
+    std::cout << "Adaptivity A/B: " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
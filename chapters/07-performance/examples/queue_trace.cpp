@@ -0,0 +1,307 @@
+#include <sycl/sycl.hpp>
+#define ACPP_EXT_EXPLICIT_BUFFER_POLICIES
+#include <hipSYCL/sycl/buffer_explicit_behavior.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Queue profiling with Chrome trace export
+//
+// A queue constructed with property::queue::enable_profiling timestamps every command it runs:
+//   command_submit - when the host handed the command to the runtime
+//   command_start  - when the device started executing it
+//   command_end    - when it finished
+// profiling_queue wraps such a queue and remembers a label for every kernel and memcpy it
+// submits; a kernel's label is its kernel name. write_chrome_trace() turns the records into
+// the Trace Event JSON format, which chrome://tracing and https://ui.perfetto.dev open as a
+// timeline: one track for device execution, one for the time each command spent queued.
+
+// Kernel names, declared up front so profiling_queue::submit can take them as well
+class InitKernel;
+class UpdateKernel;
+class CopyKernel;
+class NormKernel;
+class MatMulKernel;
+
+// Unqualified name of a type as spelled in the source, e.g. "UpdateKernel". Unlike typeid this
+// works on incomplete types, so a forward-declared kernel name is enough.
+template <class T>
+std::string type_name() {
+    // clang: "... [T = UpdateKernel]", gcc: "... [with T = UpdateKernel; ...]"
+    const std::string f = __PRETTY_FUNCTION__;
+    const size_t begin = f.find("T = ") + 4;
+    std::string name = f.substr(begin, f.find_first_of(";]", begin) - begin);
+    const size_t colon = name.rfind("::");
+    return colon == std::string::npos ? name : name.substr(colon + 2);
+}
+
+struct timed_command {
+    std::string label;
+    std::string category; // "kernel" or "memcpy"
+    uint64_t submit_ns;
+    uint64_t start_ns;
+    uint64_t end_ns;
+};
+
+class profiling_queue {
+public:
+    profiling_queue()
+        : q_{sycl::default_selector_v,
+             sycl::property_list{sycl::property::queue::in_order{}, sycl::property::queue::enable_profiling{}}} {}
+
+    explicit profiling_queue(const sycl::device& dev)
+        : q_{dev, sycl::property_list{sycl::property::queue::in_order{}, sycl::property::queue::enable_profiling{}}} {}
+
+    // Same as queue::submit; KernelName is the name cgf passes to parallel_for and labels the
+    // command in the trace
+    template <class KernelName, class CommandGroup>
+    sycl::event submit(CommandGroup&& cgf) {
+        sycl::event ev = q_.submit(std::forward<CommandGroup>(cgf));
+        pending_.push_back({type_name<KernelName>(), "kernel", ev});
+        return ev;
+    }
+
+    sycl::event memcpy(const std::string& label, void* dst, const void* src, size_t bytes) {
+        sycl::event ev = q_.memcpy(dst, src, bytes);
+        pending_.push_back({label, "memcpy", ev});
+        return ev;
+    }
+
+    void wait() { q_.wait(); }
+    sycl::queue& get() { return q_; }
+    sycl::device get_device() const { return q_.get_device(); }
+
+    // Waits for everything submitted so far and resolves the timestamps
+    const std::vector<timed_command>& commands() {
+        q_.wait();
+        for (auto& p : pending_) {
+            completed_.push_back(timed_command{
+                p.label, p.category,
+                p.ev.get_profiling_info<sycl::info::event_profiling::command_submit>(),
+                p.ev.get_profiling_info<sycl::info::event_profiling::command_start>(),
+                p.ev.get_profiling_info<sycl::info::event_profiling::command_end>()});
+        }
+        pending_.clear();
+        return completed_;
+    }
+
+    // Chrome Trace Event format: "X" (complete) events, timestamps in microseconds relative to
+    // the first submission. tid 1 shows device execution, tid 2 the submit -> start delay.
+    bool write_chrome_trace(const std::string& path) {
+        const auto& cmds = commands();
+        uint64_t t0 = cmds.empty() ? 0 : UINT64_MAX;
+        for (const auto& c : cmds) {
+            t0 = std::min(t0, c.submit_ns);
+        }
+        std::string device = q_.get_device().get_info<sycl::info::device::name>();
+
+        std::ofstream out{path};
+        out << std::fixed << std::setprecision(3);
+        out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+        out << "  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \""
+            << json_escape(device) << "\"}},\n";
+        out << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 1, \"args\": {\"name\": \"device\"}},\n";
+        out << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 2, \"args\": {\"name\": \"queued\"}}";
+        for (const auto& c : cmds) {
+            double submit_us = static_cast<double>(c.submit_ns - t0) / 1000.0;
+            double start_us = static_cast<double>(c.start_ns - t0) / 1000.0;
+            double end_us = static_cast<double>(c.end_ns - t0) / 1000.0;
+            out << ",\n  {\"name\": \"" << json_escape(c.label) << "\", \"cat\": \"" << c.category
+                << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": " << start_us
+                << ", \"dur\": " << end_us - start_us << "}";
+            if (start_us > submit_us) {
+                out << ",\n  {\"name\": \"" << json_escape(c.label) << "\", \"cat\": \"queued\""
+                    << ", \"ph\": \"X\", \"pid\": 1, \"tid\": 2, \"ts\": " << submit_us
+                    << ", \"dur\": " << start_us - submit_us << "}";
+            }
+        }
+        out << "\n]}\n";
+        return static_cast<bool>(out);
+    }
+
+private:
+    struct pending_command {
+        std::string label;
+        std::string category;
+        sycl::event ev;
+    };
+
+    static std::string json_escape(const std::string& s) {
+        std::string r;
+        for (char ch : s) {
+            if (ch == '"' || ch == '\\') {
+                r += '\\';
+            }
+            r += ch;
+        }
+        return r;
+    }
+
+    sycl::queue q_;
+    std::vector<pending_command> pending_;
+    std::vector<timed_command> completed_;
+};
+
+// A simplified copy of the Chapter 09 Jacobi iteration, with every command labelled
+float run_jacobi(profiling_queue& pq, size_t n, int iters) {
+    auto x_cur_buf = sycl::make_async_buffer<float>(sycl::range<1>{n});
+    auto x_new_buf = sycl::make_async_buffer<float>(sycl::range<1>{n});
+    float* norm_ptr = sycl::malloc_device<float>(1, pq.get());
+    const float zero = 0.0f;
+    float norm = 0.0f;
+
+    pq.submit<InitKernel>([&](sycl::handler& cgh) {
+        auto x = sycl::accessor{x_cur_buf, cgh, sycl::write_only};
+        cgh.parallel_for<InitKernel>(sycl::range<1>{n}, [=](sycl::id<1> i) {
+            x[i] = 0.0f;
+        });
+    });
+
+    for (int iter = 0; iter < iters; ++iter) {
+        pq.submit<UpdateKernel>([&](sycl::handler& cgh) {
+            auto x_cur = sycl::accessor{x_cur_buf, cgh, sycl::read_only};
+            auto x_new = sycl::accessor{x_new_buf, cgh, sycl::write_only};
+            cgh.parallel_for<UpdateKernel>(sycl::range<1>{n}, [=](sycl::id<1> i) {
+                float v = 1.0f;
+                if (i[0] > 0) {
+                    v += x_cur[i[0] - 1];
+                }
+                if (i[0] < n - 1) {
+                    v += x_cur[i[0] + 1];
+                }
+                x_new[i] = v / 4.0f;
+            });
+        });
+        pq.submit<CopyKernel>([&](sycl::handler& cgh) {
+            auto x_new = sycl::accessor{x_new_buf, cgh, sycl::read_only};
+            auto x_cur = sycl::accessor{x_cur_buf, cgh, sycl::write_only};
+            cgh.parallel_for<CopyKernel>(sycl::range<1>{n}, [=](sycl::id<1> i) {
+                x_cur[i] = x_new[i];
+            });
+        });
+        if (iter % 10 == 9) {
+            pq.memcpy("ResetNorm", norm_ptr, &zero, sizeof(float));
+            pq.submit<NormKernel>([&](sycl::handler& cgh) {
+                auto x = sycl::accessor{x_cur_buf, cgh, sycl::read_only};
+                cgh.parallel_for<NormKernel>(sycl::range<1>{n}, sycl::reduction(norm_ptr, sycl::plus<float>()),
+                                                   [=](sycl::id<1> i, auto& sum) {
+                                                       sum += sycl::fabs(x[i]);
+                                                   });
+            });
+            pq.memcpy("ReadNorm", &norm, norm_ptr, sizeof(float));
+            pq.wait();
+        }
+    }
+    pq.wait();
+    sycl::free(norm_ptr, pq.get());
+    return norm;
+}
+
+// A simplified copy of the Chapter 09 tiled matrix multiply; returns c[1][1]
+float run_matmul(profiling_queue& pq, size_t n) {
+    constexpr size_t TILE = 16;
+    std::vector<float> a(n * n), b(n * n), c(n * n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            a[i * n + j] = static_cast<float>(i + 1);
+            b[i * n + j] = static_cast<float>(j + 1);
+        }
+    }
+    {
+        auto a_buf = sycl::make_sync_view(a.data(), sycl::range<2>{n, n});
+        auto b_buf = sycl::make_sync_view(b.data(), sycl::range<2>{n, n});
+        auto c_buf = sycl::make_sync_writeback_view(c.data(), sycl::range<2>{n, n});
+        pq.submit<MatMulKernel>([&](sycl::handler& cgh) {
+            auto a_acc = sycl::accessor{a_buf, cgh, sycl::read_only};
+            auto b_acc = sycl::accessor{b_buf, cgh, sycl::read_only};
+            auto c_acc = sycl::accessor{c_buf, cgh, sycl::write_only};
+            sycl::local_accessor<float, 2> a_tile{sycl::range<2>{TILE, TILE}, cgh};
+            sycl::local_accessor<float, 2> b_tile{sycl::range<2>{TILE, TILE}, cgh};
+            sycl::nd_range<2> range{sycl::range<2>{n, n}, sycl::range<2>{TILE, TILE}};
+            cgh.parallel_for<MatMulKernel>(range, [=](sycl::nd_item<2> item) {
+                size_t row = item.get_global_id(0);
+                size_t col = item.get_global_id(1);
+                size_t lr = item.get_local_id(0);
+                size_t lc = item.get_local_id(1);
+                float sum = 0.0f;
+                for (size_t t = 0; t < n / TILE; ++t) {
+                    a_tile[lr][lc] = a_acc[row][t * TILE + lc];
+                    b_tile[lr][lc] = b_acc[t * TILE + lr][col];
+                    sycl::group_barrier(item.get_group());
+                    for (size_t k = 0; k < TILE; ++k) {
+                        sum += a_tile[lr][k] * b_tile[k][lc];
+                    }
+                    sycl::group_barrier(item.get_group());
+                }
+                c_acc[row][col] = sum;
+            });
+        });
+        pq.wait();
+    }
+    return c[1 * n + 1];
+}
+
+int main(int argc, char* argv[]) {
+    std::string path = argc > 1 ? argv[1] : "queue_trace.json";
+    const size_t JACOBI_N = 1 << 20;
+    const int JACOBI_ITERS = 50;
+    const size_t MATMUL_N = 512;
+
+    try {
+        profiling_queue pq;
+        std::cout << "Using device: " << pq.get_device().get_info<sycl::info::device::name>() << std::endl;
+
+        float norm = run_jacobi(pq, JACOBI_N, JACOBI_ITERS);
+        float c11 = run_matmul(pq, MATMUL_N);
+
+        // Per-label summary
+        struct label_summary {
+            size_t count = 0;
+            double device_ms = 0.0;
+            double queued_ms = 0.0;
+        };
+        std::map<std::string, label_summary> summary;
+        bool ordered = true;
+        for (const auto& c : pq.commands()) {
+            ordered = ordered && c.submit_ns <= c.start_ns && c.start_ns <= c.end_ns;
+            auto& s = summary[c.label];
+            s.count++;
+            s.device_ms += static_cast<double>(c.end_ns - c.start_ns) / 1e6;
+            s.queued_ms += static_cast<double>(c.start_ns - c.submit_ns) / 1e6;
+        }
+
+        std::cout << std::left << std::setw(16) << "Command"
+                  << std::right << std::setw(8) << "count"
+                  << std::setw(14) << "device ms"
+                  << std::setw(14) << "avg us"
+                  << std::setw(16) << "avg queued us" << std::endl;
+        for (const auto& [label, s] : summary) {
+            std::cout << std::left << std::setw(16) << label
+                      << std::right << std::setw(8) << s.count
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(14) << s.device_ms
+                      << std::setw(14) << s.device_ms * 1000.0 / s.count
+                      << std::setw(16) << s.queued_ms * 1000.0 / s.count << std::endl;
+        }
+
+        bool written = pq.write_chrome_trace(path);
+        std::cout << "Trace written to " << path << " (open in chrome://tracing or ui.perfetto.dev)" << std::endl;
+
+        const size_t expected_commands = 1 + 2 * JACOBI_ITERS + 3 * (JACOBI_ITERS / 10) + 1;
+        bool ok = written && ordered && pq.commands().size() == expected_commands && norm > 0.0f &&
+                  std::abs(c11 - 4.0f * MATMUL_N) < 1e-3f;
+        std::cout << "Queue trace: " << (ok ? "OK" : "FAILED") << std::endl;
+        return ok ? 0 : 1;
+
+    } catch (const sycl::exception& e) {
+        std::cout << "SYCL exception caught: " << e.what() << std::endl;
+        return 1;
+    }
+}
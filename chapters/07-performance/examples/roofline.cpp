@@ -0,0 +1,388 @@
+#include <sycl/sycl.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Roofline report
+//
+// The roofline model bounds a kernel's throughput by two device limits:
+//
+//   attainable FLOP/s = min(peak FLOP/s, arithmetic intensity * peak bandwidth)
+//
+// where arithmetic intensity (AI) is FLOPs per byte of memory traffic. Kernels left of the
+// ridge point (AI = peak FLOP/s / peak bandwidth) are memory bound, kernels right of it are
+// compute bound. The distance to the roof tells how much headroom a kernel still has.
+//
+// For each device this example measures
+//   peak bandwidth - STREAM triad, a[i] = b[i] + s * c[i] (the bandwidth_benchmark pattern)
+//   peak FLOP/s    - a chain of independent FMAs per work-item, no memory traffic
+// then runs the guide's kernels, each declaring its FLOPs and its compulsory memory traffic
+// (every input read once, every output written once). It prints a table and writes one SVG
+// roofline plot per device.
+
+using clock_type = std::chrono::high_resolution_clock;
+
+// Best-of-reps wall time in seconds; the first call is a warm-up (JIT)
+double time_best(sycl::queue& q, int reps, const std::function<void()>& run) {
+    run();
+    q.wait();
+    double best = 1e30;
+    for (int r = 0; r < reps; ++r) {
+        auto t0 = clock_type::now();
+        run();
+        q.wait();
+        best = std::min(best, std::chrono::duration<double>(clock_type::now() - t0).count());
+    }
+    return best;
+}
+
+struct kernel_result {
+    std::string name;
+    double flops;
+    double bytes;
+    double seconds;
+    double intensity() const { return flops / bytes; }
+    double gflops() const { return flops / seconds / 1e9; }
+};
+
+struct device_roofs {
+    double bandwidth_gbs;
+    double peak_gflops;
+    double roof(double intensity) const { return std::min(peak_gflops, intensity * bandwidth_gbs); }
+};
+
+device_roofs measure_roofs(sycl::queue& q, size_t n) {
+    const int REPS = 5;
+    device_roofs roofs{};
+
+    // STREAM triad
+    float* a = sycl::malloc_device<float>(n, q);
+    float* b = sycl::malloc_device<float>(n, q);
+    float* c = sycl::malloc_device<float>(n, q);
+    q.fill(b, 1.0f, n);
+    q.fill(c, 2.0f, n).wait();
+    const float s = 3.0f;
+    double t = time_best(q, REPS, [&] {
+        q.parallel_for<class TriadKernel>(sycl::range<1>{n}, [=](sycl::id<1> i) {
+            a[i] = b[i] + s * c[i];
+        });
+    });
+    roofs.bandwidth_gbs = 3.0 * n * sizeof(float) / t / 1e9;
+
+    // FMA chain: 8 independent accumulators hide FMA latency, ITERS keeps memory traffic
+    // negligible. 2 FLOPs per FMA.
+    const size_t GLOBAL = 1 << 19;
+    const int ITERS = 1024;
+    const float mul = 0.999999f;
+    const float add = 1e-7f;
+    // Own sink: a holds only n floats, which can be fewer than GLOBAL
+    float* sink = sycl::malloc_device<float>(GLOBAL, q);
+    double t_fma = time_best(q, REPS, [&] {
+        q.parallel_for<class FmaChainKernel>(sycl::range<1>{GLOBAL}, [=](sycl::id<1> idx) {
+            float x0 = static_cast<float>(idx[0]) * 1e-6f;
+            float x1 = x0 + 1.0f, x2 = x0 + 2.0f, x3 = x0 + 3.0f;
+            float x4 = x0 + 4.0f, x5 = x0 + 5.0f, x6 = x0 + 6.0f, x7 = x0 + 7.0f;
+            for (int k = 0; k < ITERS; ++k) {
+                x0 = sycl::fma(x0, mul, add);
+                x1 = sycl::fma(x1, mul, add);
+                x2 = sycl::fma(x2, mul, add);
+                x3 = sycl::fma(x3, mul, add);
+                x4 = sycl::fma(x4, mul, add);
+                x5 = sycl::fma(x5, mul, add);
+                x6 = sycl::fma(x6, mul, add);
+                x7 = sycl::fma(x7, mul, add);
+            }
+            sink[idx] = x0 + x1 + x2 + x3 + x4 + x5 + x6 + x7; // keep the chain alive
+        });
+    });
+    roofs.peak_gflops = 2.0 * 8 * ITERS * static_cast<double>(GLOBAL) / t_fma / 1e9;
+
+    sycl::free(sink, q);
+    sycl::free(a, q);
+    sycl::free(b, q);
+    sycl::free(c, q);
+    return roofs;
+}
+
+// The guide's kernels with their declared FLOPs and compulsory bytes. Sets ok = false when a
+// kernel computes a wrong result.
+std::vector<kernel_result> run_kernels(sycl::queue& q, size_t n, bool& ok) {
+    const int REPS = 5;
+    std::vector<kernel_result> results;
+
+    float* x = sycl::malloc_device<float>(n, q);
+    float* y = sycl::malloc_device<float>(n, q);
+    float* z = sycl::malloc_device<float>(n, q);
+    float* sum = sycl::malloc_device<float>(1, q);
+    q.fill(x, 1.0f, n);
+    q.fill(y, 2.0f, n).wait();
+
+    // Vector add (Chapter 04/07): 1 FLOP, 3 floats per element
+    double t = time_best(q, REPS, [&] {
+        q.parallel_for<class VectorAddKernel>(sycl::range<1>{n}, [=](sycl::id<1> i) {
+            z[i] = x[i] + y[i];
+        });
+    });
+    results.push_back({"vector add", 1.0 * n, 3.0 * n * sizeof(float), t});
+    float check = 0.0f;
+    q.memcpy(&check, z + n - 1, sizeof(float)).wait();
+    ok = ok && check == 3.0f;
+
+    // Jacobi update (Chapter 09): 2 adds + 1 divide, reads x once, writes z once
+    t = time_best(q, REPS, [&] {
+        q.parallel_for<class JacobiUpdateKernel>(sycl::range<1>{n}, [=](sycl::id<1> idx) {
+            size_t i = idx[0];
+            float v = 1.0f;
+            if (i > 0) {
+                v += x[i - 1];
+            }
+            if (i < n - 1) {
+                v += x[i + 1];
+            }
+            z[i] = v / 4.0f;
+        });
+    });
+    results.push_back({"jacobi update", 3.0 * n, 2.0 * n * sizeof(float), t});
+    q.memcpy(&check, z + n / 2, sizeof(float)).wait();
+    ok = ok && check == 0.75f;
+
+    // Sum reduction (Chapter 05/09): 1 add per element, reads x once. Capped at 2^24 elements,
+    // where a float sum of ones is still exact.
+    const size_t n_red = std::min<size_t>(n, 1 << 24);
+    t = time_best(q, REPS, [&] {
+        q.memset(sum, 0, sizeof(float));
+        q.submit([&](sycl::handler& cgh) {
+            cgh.parallel_for<class SumReductionKernel>(sycl::range<1>{n_red}, sycl::reduction(sum, sycl::plus<float>()),
+                                                       [=](sycl::id<1> i, auto& s) {
+                                                           s += x[i];
+                                                       });
+        });
+    });
+    results.push_back({"sum reduction", 1.0 * n_red, 1.0 * n_red * sizeof(float), t});
+    q.memcpy(&check, sum, sizeof(float)).wait();
+    ok = ok && check == static_cast<float>(n_red);
+
+    sycl::free(x, q);
+    sycl::free(y, q);
+    sycl::free(z, q);
+    sycl::free(sum, q);
+
+    // Tiled matmul (Chapter 09): 2 m^3 FLOPs, A and B read once, C written once
+    const size_t M = 1024;
+    const size_t TILE = 16;
+    float* a = sycl::malloc_device<float>(M * M, q);
+    float* b = sycl::malloc_device<float>(M * M, q);
+    float* c = sycl::malloc_device<float>(M * M, q);
+    q.fill(a, 1.0f, M * M);
+    q.fill(b, 2.0f, M * M).wait();
+    t = time_best(q, REPS, [&] {
+        q.submit([&](sycl::handler& cgh) {
+            sycl::local_accessor<float, 1> a_tile{TILE * TILE, cgh};
+            sycl::local_accessor<float, 1> b_tile{TILE * TILE, cgh};
+            sycl::nd_range<2> range{sycl::range<2>{M, M}, sycl::range<2>{TILE, TILE}};
+            cgh.parallel_for<class MatMulKernel>(range, [=](sycl::nd_item<2> item) {
+                size_t row = item.get_global_id(0);
+                size_t col = item.get_global_id(1);
+                size_t lr = item.get_local_id(0);
+                size_t lc = item.get_local_id(1);
+                float acc = 0.0f;
+                for (size_t k0 = 0; k0 < M; k0 += TILE) {
+                    a_tile[lr * TILE + lc] = a[row * M + k0 + lc];
+                    b_tile[lr * TILE + lc] = b[(k0 + lr) * M + col];
+                    sycl::group_barrier(item.get_group());
+                    for (size_t k = 0; k < TILE; ++k) {
+                        acc += a_tile[lr * TILE + k] * b_tile[k * TILE + lc];
+                    }
+                    sycl::group_barrier(item.get_group());
+                }
+                c[row * M + col] = acc;
+            });
+        });
+    });
+    results.push_back({"tiled matmul", 2.0 * M * M * M, 3.0 * M * M * sizeof(float), t});
+    q.memcpy(&check, c + M * M - 1, sizeof(float)).wait();
+    ok = ok && check == 2.0f * M;
+
+    sycl::free(a, q);
+    sycl::free(b, q);
+    sycl::free(c, q);
+    return results;
+}
+
+// Log-log roofline plot: the bandwidth slope, the compute ceiling and one point per kernel
+void write_svg(const std::string& path, const std::string& device, const device_roofs& roofs,
+               const std::vector<kernel_result>& results) {
+    const double W = 720, H = 480, L = 70, R = 20, T = 40, B = 50;
+    const double x_min = 1.0 / 16, x_max = 1024;
+    const double y_max = std::pow(10.0, std::ceil(std::log10(roofs.peak_gflops * 2)));
+    const double y_min = y_max / 1e5;
+    auto px = [&](double ai) { return L + (W - L - R) * std::log(ai / x_min) / std::log(x_max / x_min); };
+    auto py = [&](double gf) {
+        gf = std::max(gf, y_min);
+        return H - B - (H - T - B) * std::log(gf / y_min) / std::log(y_max / y_min);
+    };
+
+    std::ofstream out{path};
+    out << std::fixed << std::setprecision(1);
+    out << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << W << "\" height=\"" << H
+        << "\" font-family=\"sans-serif\" font-size=\"12\">\n";
+    out << "<rect width=\"100%\" height=\"100%\" fill=\"white\"/>\n";
+    out << "<text x=\"" << W / 2 << "\" y=\"24\" text-anchor=\"middle\" font-size=\"14\">Roofline: " << device
+        << "</text>\n";
+
+    // Grid and axis labels, one line per power of ten / power of four
+    for (double ai = x_min; ai <= x_max; ai *= 4) {
+        out << "<line x1=\"" << px(ai) << "\" y1=\"" << T << "\" x2=\"" << px(ai) << "\" y2=\"" << H - B
+            << "\" stroke=\"#ddd\"/>\n";
+        out << "<text x=\"" << px(ai) << "\" y=\"" << H - B + 16 << "\" text-anchor=\"middle\">" << ai << "</text>\n";
+    }
+    for (double gf = y_min; gf <= y_max * 1.001; gf *= 10) {
+        out << "<line x1=\"" << L << "\" y1=\"" << py(gf) << "\" x2=\"" << W - R << "\" y2=\"" << py(gf)
+            << "\" stroke=\"#ddd\"/>\n";
+        out << "<text x=\"" << L - 6 << "\" y=\"" << py(gf) + 4 << "\" text-anchor=\"end\">" << gf << "</text>\n";
+    }
+    out << "<text x=\"" << (L + W - R) / 2 << "\" y=\"" << H - 12
+        << "\" text-anchor=\"middle\">Arithmetic intensity (FLOP/byte)</text>\n";
+    out << "<text x=\"16\" y=\"" << (T + H - B) / 2 << "\" text-anchor=\"middle\" transform=\"rotate(-90 16 "
+        << (T + H - B) / 2 << ")\">GFLOP/s</text>\n";
+
+    // Roof: bandwidth slope up to the ridge point, then the compute ceiling
+    double ridge = roofs.peak_gflops / roofs.bandwidth_gbs;
+    out << "<polyline fill=\"none\" stroke=\"black\" stroke-width=\"2\" points=\"" << px(x_min) << ","
+        << py(x_min * roofs.bandwidth_gbs) << " " << px(ridge) << "," << py(roofs.peak_gflops) << " " << px(x_max)
+        << "," << py(roofs.peak_gflops) << "\"/>\n";
+    out << "<text x=\"" << px(x_max) - 4 << "\" y=\"" << py(roofs.peak_gflops) - 6 << "\" text-anchor=\"end\">"
+        << roofs.peak_gflops << " GFLOP/s (FMA)</text>\n";
+    out << "<text x=\"" << px(x_min) + 4 << "\" y=\"" << py(x_min * roofs.bandwidth_gbs) - 6 << "\">"
+        << roofs.bandwidth_gbs << " GB/s (triad)</text>\n";
+
+    const char* colors[] = {"#1f77b4", "#d62728", "#2ca02c", "#9467bd", "#ff7f0e", "#8c564b"};
+    for (size_t k = 0; k < results.size(); ++k) {
+        const auto& r = results[k];
+        const char* color = colors[k % 6];
+        out << "<circle cx=\"" << px(r.intensity()) << "\" cy=\"" << py(r.gflops()) << "\" r=\"5\" fill=\"" << color
+            << "\"/>\n";
+        out << "<text x=\"" << px(r.intensity()) + 8 << "\" y=\"" << py(r.gflops()) + 4 << "\" fill=\"" << color
+            << "\">" << r.name << "</text>\n";
+    }
+    out << "</svg>\n";
+}
+
+// Machine-readable results for scripts/perf.nu: one entry per device, all metrics are
+// higher-is-better rates (GB/s for the triad, GFLOP/s otherwise)
+struct device_record {
+    std::string name;
+    std::string type;
+    device_roofs roofs;
+    std::vector<kernel_result> results;
+};
+
+std::string metric_key(std::string name) {
+    std::replace(name.begin(), name.end(), ' ', '_');
+    return name + "_gflops";
+}
+
+bool write_json(const std::string& path, const std::vector<device_record>& devices) {
+    std::ofstream out{path};
+    out << std::setprecision(6) << "[\n";
+    for (size_t d = 0; d < devices.size(); ++d) {
+        const auto& rec = devices[d];
+        std::string name;
+        for (char ch : rec.name) {
+            if (ch == '"' || ch == '\\') {
+                name += '\\';
+            }
+            name += ch;
+        }
+        out << "  {\"device\": \"" << name << "\", \"type\": \"" << rec.type << "\", \"metrics\": {"
+            << "\"triad_gbs\": " << rec.roofs.bandwidth_gbs << ", \"fma_gflops\": " << rec.roofs.peak_gflops;
+        for (const auto& r : rec.results) {
+            out << ", \"" << metric_key(r.name) << "\": " << r.gflops();
+        }
+        out << "}}" << (d + 1 < devices.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+    return static_cast<bool>(out);
+}
+
+int main(int argc, char* argv[]) {
+    // Usage: roofline [N] [--json <path>]
+    //   N      STREAM/vector array size in floats (default 64M, capped per device)
+    //   --json also write the measured rates to <path> (used by pixi run perf)
+    size_t N = 64 * 1024 * 1024;
+    std::string json_path;
+    for (int a = 1; a < argc; ++a) {
+        std::string arg = argv[a];
+        if (arg == "--json" && a + 1 < argc) {
+            json_path = argv[++a];
+            continue;
+        }
+        try {
+            N = std::stoull(arg);
+        } catch (const std::exception& e) {
+            std::cerr << "Error parsing N: " << e.what() << std::endl;
+            return 1;
+        }
+        if (N == 0) {
+            std::cerr << "Error: N must be at least 1" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<device_record> records;
+    bool ok = true;
+    int index = 0;
+    for (const auto& dev : sycl::device::get_devices()) {
+        sycl::queue q{dev, sycl::property_list{sycl::property::queue::in_order{}}};
+        std::string name = dev.get_info<sycl::info::device::name>();
+        size_t n = std::min<size_t>(N, dev.get_info<sycl::info::device::max_mem_alloc_size>() / sizeof(float));
+
+        device_roofs roofs = measure_roofs(q, n);
+        std::vector<kernel_result> results = run_kernels(q, n, ok);
+
+        std::cout << std::endl << "Device " << index << ": " << name << std::endl;
+        std::cout << std::fixed << std::setprecision(1) << "Peak bandwidth: " << roofs.bandwidth_gbs
+                  << " GB/s, peak compute: " << roofs.peak_gflops << " GFLOP/s, ridge point: "
+                  << std::setprecision(2) << roofs.peak_gflops / roofs.bandwidth_gbs << " FLOP/byte" << std::endl;
+        std::cout << std::left << std::setw(16) << "Kernel"
+                  << std::right << std::setw(12) << "FLOP/byte"
+                  << std::setw(12) << "GFLOP/s"
+                  << std::setw(12) << "roof"
+                  << std::setw(12) << "% of roof"
+                  << std::setw(10) << "bound" << std::endl;
+        for (const auto& r : results) {
+            double roof = roofs.roof(r.intensity());
+            bool memory_bound = r.intensity() < roofs.peak_gflops / roofs.bandwidth_gbs;
+            std::cout << std::left << std::setw(16) << r.name
+                      << std::right << std::setprecision(3) << std::setw(12) << r.intensity()
+                      << std::setprecision(2) << std::setw(12) << r.gflops()
+                      << std::setw(12) << roof
+                      << std::setprecision(1) << std::setw(12) << 100.0 * r.gflops() / roof
+                      << std::setw(10) << (memory_bound ? "memory" : "compute") << std::endl;
+        }
+
+        std::string svg = "roofline_device" + std::to_string(index) + ".svg";
+        write_svg(svg, name, roofs, results);
+        std::cout << "Plot written to " << svg << std::endl;
+        records.push_back({name, dev.is_cpu() ? "cpu" : (dev.is_gpu() ? "gpu" : "other"), roofs, results});
+        ++index;
+    }
+
+    if (!json_path.empty() && !write_json(json_path, records)) {
+        std::cerr << "Failed to write " << json_path << std::endl;
+        ok = false;
+    }
+
+    // [!NOTE]: Bytes are the compulsory traffic. A kernel above 100% gets some of its data from
+    // cache rather than memory (small Jacobi or matmul inputs on a CPU); far below 100% means
+    // more traffic than necessary or too little parallelism.
+
+    std::cout << std::endl << "Roofline: " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
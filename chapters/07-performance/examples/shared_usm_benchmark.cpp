@@ -0,0 +1,215 @@
+#include <sycl/sycl.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Shared USM migration benchmark
+//
+// malloc_shared memory is reachable from host and device, but it has to live somewhere. When
+// the host and the device take turns touching it, the backend migrates pages back and forth
+// (on demand via page faults, or eagerly when asked with q.prefetch / q.mem_advise). This
+// benchmark runs the vector add with host and device alternating each iteration and splits
+// the time into phases, so the migration cost becomes visible:
+//
+//   host write  - host fills a and b
+//   to device   - explicit transfer: memcpy (device USM) or prefetch (shared), if any
+//   kernel      - c = a + b; for shared USM this absorbs on-demand page migration
+//   host read   - host reads c (after a memcpy back for device USM)
+//
+// The device USM + memcpy variant is the reference; "migration" is the extra kernel + host
+// read time a shared variant pays over it.
+
+// Backend-specific mem_advise values. AdaptiveCpp forwards the integer to the backend: these
+// are the CUDA values (cudaMemAdviseSetReadMostly / SetPreferredLocation). Backends without
+// an equivalent (OpenMP, OpenCL/pocl) ignore the hint.
+constexpr int ADVISE_READ_MOSTLY = 1;
+constexpr int ADVISE_PREFERRED_LOCATION = 3;
+
+enum class variant { device_memcpy, shared_plain, shared_prefetch, shared_advise, shared_prefetch_advise };
+enum class access_pattern { full, sparse };
+
+const char* variant_name(variant v) {
+    switch (v) {
+        case variant::device_memcpy: return "device + memcpy";
+        case variant::shared_plain: return "shared";
+        case variant::shared_prefetch: return "shared + prefetch";
+        case variant::shared_advise: return "shared + advise";
+        case variant::shared_prefetch_advise: return "shared + both";
+    }
+    return "";
+}
+
+struct phase_times {
+    double host_write_ms = 0.0;
+    double to_device_ms = 0.0;
+    double kernel_ms = 0.0;
+    double host_read_ms = 0.0;
+    double total() const { return host_write_ms + to_device_ms + kernel_ms + host_read_ms; }
+};
+
+using clock_type = std::chrono::high_resolution_clock;
+
+double ms_since(clock_type::time_point t0) {
+    return std::chrono::duration<double, std::milli>(clock_type::now() - t0).count();
+}
+
+// Returns phase times averaged over iterations; sets ok = false on a wrong result
+phase_times run(sycl::queue& q, variant v, access_pattern pattern, size_t N, int iters, bool& ok) {
+    const bool shared = v != variant::device_memcpy;
+    const bool prefetch = v == variant::shared_prefetch || v == variant::shared_prefetch_advise;
+    const bool advise = v == variant::shared_advise || v == variant::shared_prefetch_advise;
+    const size_t bytes = N * sizeof(float);
+    // Sparse: the host touches one float per 4 KiB page, i.e. every page but little data
+    const size_t stride = pattern == access_pattern::full ? 1 : 4096 / sizeof(float);
+
+    float *a, *b, *c;
+    std::vector<float> h_a, h_b, h_c;
+    if (shared) {
+        a = sycl::malloc_shared<float>(N, q);
+        b = sycl::malloc_shared<float>(N, q);
+        c = sycl::malloc_shared<float>(N, q);
+    } else {
+        a = sycl::malloc_device<float>(N, q);
+        b = sycl::malloc_device<float>(N, q);
+        c = sycl::malloc_device<float>(N, q);
+        h_a.resize(N);
+        h_b.resize(N);
+        h_c.resize(N);
+    }
+    float* wa = shared ? a : h_a.data();
+    float* wb = shared ? b : h_b.data();
+    float* rc = shared ? c : h_c.data();
+
+    if (advise) {
+        // Inputs are produced by the host and only read by the device; the output lives on
+        // the device until the host reads it
+        q.mem_advise(a, bytes, ADVISE_READ_MOSTLY);
+        q.mem_advise(b, bytes, ADVISE_READ_MOSTLY);
+        q.mem_advise(c, bytes, ADVISE_PREFERRED_LOCATION);
+        q.wait();
+    }
+
+    phase_times sum;
+    for (int it = 0; it <= iters; ++it) { // iteration 0 is warm-up
+        phase_times t;
+        const float value = static_cast<float>(it);
+
+        auto t0 = clock_type::now();
+        for (size_t i = 0; i < N; i += stride) {
+            wa[i] = value;
+            wb[i] = 1.0f;
+        }
+        t.host_write_ms = ms_since(t0);
+
+        t0 = clock_type::now();
+        if (!shared) {
+            q.memcpy(a, wa, bytes);
+            q.memcpy(b, wb, bytes);
+            q.wait();
+        } else if (prefetch) {
+            q.prefetch(a, bytes);
+            q.prefetch(b, bytes);
+            q.wait();
+        }
+        t.to_device_ms = ms_since(t0);
+
+        t0 = clock_type::now();
+        q.parallel_for(sycl::range<1>{N}, [=](sycl::id<1> i) {
+            c[i] = a[i] + b[i];
+        }).wait();
+        t.kernel_ms = ms_since(t0);
+
+        t0 = clock_type::now();
+        if (!shared) {
+            q.memcpy(rc, c, bytes).wait();
+        }
+        // Every sampled element must hold this pass's result: a stale page from an earlier
+        // pass holds a smaller value
+        bool pass_ok = true;
+        for (size_t i = 0; i < N; i += stride) {
+            if (rc[i] != value + 1.0f) {
+                pass_ok = false;
+            }
+        }
+        t.host_read_ms = ms_since(t0);
+        ok = ok && pass_ok;
+        if (it > 0) {
+            sum.host_write_ms += t.host_write_ms / iters;
+            sum.to_device_ms += t.to_device_ms / iters;
+            sum.kernel_ms += t.kernel_ms / iters;
+            sum.host_read_ms += t.host_read_ms / iters;
+        }
+    }
+
+    sycl::free(a, q);
+    sycl::free(b, q);
+    sycl::free(c, q);
+    return sum;
+}
+
+int main(int argc, char* argv[]) {
+    size_t N = 16 * 1024 * 1024; // 64 MiB per array
+    if (argc > 1) {
+        try {
+            N = std::stoull(argv[1]);
+        } catch (const std::exception& e) {
+            std::cerr << "Error parsing N: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    const int ITERS = 10;
+
+    sycl::queue q{sycl::default_selector_v, sycl::property_list{sycl::property::queue::in_order{}}};
+    auto dev = q.get_device();
+    std::cout << "Using device: " << dev.get_info<sycl::info::device::name>() << std::endl;
+    if (!dev.has(sycl::aspect::usm_shared_allocations)) {
+        std::cout << "Device does not support shared USM allocations" << std::endl;
+        return 0;
+    }
+    std::cout << "N = " << N << " floats (" << (N * sizeof(float) >> 20) << " MiB per array), "
+              << ITERS << " iterations, times in ms per iteration" << std::endl;
+
+    const variant variants[] = {variant::device_memcpy, variant::shared_plain, variant::shared_prefetch,
+                                variant::shared_advise, variant::shared_prefetch_advise};
+    bool ok = true;
+
+    for (access_pattern pattern : {access_pattern::full, access_pattern::sparse}) {
+        std::cout << std::endl
+                  << (pattern == access_pattern::full ? "Host touches every element"
+                                                      : "Host touches one element per 4 KiB page")
+                  << std::endl;
+        std::cout << std::left << std::setw(20) << "Variant"
+                  << std::right << std::setw(12) << "host write"
+                  << std::setw(12) << "to device"
+                  << std::setw(12) << "kernel"
+                  << std::setw(12) << "host read"
+                  << std::setw(12) << "total"
+                  << std::setw(12) << "migration" << std::endl;
+
+        phase_times reference;
+        for (variant v : variants) {
+            phase_times t = run(q, v, pattern, N, ITERS, ok);
+            if (v == variant::device_memcpy) {
+                reference = t;
+            }
+            double migration = (t.kernel_ms + t.host_read_ms) - (reference.kernel_ms + reference.host_read_ms);
+            std::cout << std::left << std::setw(20) << variant_name(v)
+                      << std::right << std::fixed << std::setprecision(3)
+                      << std::setw(12) << t.host_write_ms
+                      << std::setw(12) << t.to_device_ms
+                      << std::setw(12) << t.kernel_ms
+                      << std::setw(12) << t.host_read_ms
+                      << std::setw(12) << t.total()
+                      << std::setw(12) << (v == variant::device_memcpy ? 0.0 : migration) << std::endl;
+        }
+    }
+
+    // [!NOTE]: On CPU backends (OpenMP, pocl) host and device share physical memory, so the
+    // migration column should be close to zero - shared USM is effectively free there. On
+    // discrete GPUs it shows the cost of page faults, and how much prefetch recovers.
+
+    std::cout << std::endl << "Shared USM benchmark: " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,288 @@
+#include <sycl/sycl.hpp>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Structure-of-arrays container with a compile-time layout switch
+//
+// Real records have many fields, but most kernels touch only some of them. With an array of
+// structs (AoS) every load drags the whole record through the cache, and consecutive
+// work-items read addresses one record apart, which defeats vector loads and coalescing.
+// With a structure of arrays (SoA) each field is contiguous, so a kernel streams exactly the
+// fields it uses.
+//
+// record_vector<Layout, Fields...> stores n records of the given field types in one USM device
+// allocation, either as SoA or AoS. Kernels use a trivially copyable record_view and address
+// fields by index - view.get<I>(i) - so switching the layout is a one-word change.
+
+enum class layout { soa, aos };
+
+template <class... Fields>
+struct record_layout {
+    static constexpr size_t num_fields = sizeof...(Fields);
+    static constexpr std::array<size_t, num_fields> sizes{sizeof(Fields)...};
+    static constexpr std::array<size_t, num_fields> aligns{alignof(Fields)...};
+
+    static constexpr size_t align_up(size_t x, size_t a) { return (x + a - 1) / a * a; }
+
+    // AoS: byte offset of each field inside one record, with C struct padding rules
+    static constexpr std::array<size_t, num_fields> aos_offsets() {
+        std::array<size_t, num_fields> off{};
+        size_t pos = 0;
+        for (size_t f = 0; f < num_fields; ++f) {
+            pos = align_up(pos, aligns[f]);
+            off[f] = pos;
+            pos += sizes[f];
+        }
+        return off;
+    }
+
+    static constexpr size_t record_align() {
+        size_t a = 1;
+        for (size_t f = 0; f < num_fields; ++f) {
+            a = aligns[f] > a ? aligns[f] : a;
+        }
+        return a;
+    }
+
+    static constexpr size_t record_size() {
+        return align_up(aos_offsets()[num_fields - 1] + sizes[num_fields - 1], record_align());
+    }
+
+    // SoA: byte offset of each field array inside the allocation. Arrays start on 64-byte
+    // boundaries so each field can be loaded with full-width vector loads.
+    static std::array<size_t, num_fields> soa_offsets(size_t n) {
+        std::array<size_t, num_fields> off{};
+        size_t pos = 0;
+        for (size_t f = 0; f < num_fields; ++f) {
+            off[f] = pos;
+            pos = align_up(pos + n * sizes[f], 64);
+        }
+        return off;
+    }
+
+    static size_t bytes(layout l, size_t n) {
+        if (l == layout::aos) {
+            return n * record_size();
+        }
+        return soa_offsets(n)[num_fields - 1] + n * sizes[num_fields - 1];
+    }
+};
+
+template <layout L, class... Fields>
+class record_view {
+public:
+    using info = record_layout<Fields...>;
+    template <size_t I>
+    using field_type = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    record_view(std::byte* base, size_t n)
+        : base_(base), n_(n), field_offsets_(L == layout::soa ? info::soa_offsets(n) : info::aos_offsets()) {}
+
+    template <size_t I>
+    field_type<I>& get(size_t i) const {
+        if constexpr (L == layout::soa) {
+            return reinterpret_cast<field_type<I>*>(base_ + field_offsets_[I])[i];
+        } else {
+            return *reinterpret_cast<field_type<I>*>(base_ + i * info::record_size() + field_offsets_[I]);
+        }
+    }
+
+    size_t size() const { return n_; }
+
+private:
+    std::byte* base_;
+    size_t n_;
+    std::array<size_t, info::num_fields> field_offsets_;
+};
+
+template <layout L, class... Fields>
+class record_vector {
+public:
+    using view_type = record_view<L, Fields...>;
+    using info = record_layout<Fields...>;
+
+    record_vector(sycl::queue& q, size_t n)
+        : q_(q), n_(n), bytes_(info::bytes(L, n)), data_(sycl::malloc_device<std::byte>(bytes_, q)) {}
+
+    ~record_vector() { sycl::free(data_, q_); }
+
+    record_vector(const record_vector&) = delete;
+    record_vector& operator=(const record_vector&) = delete;
+
+    view_type view() const { return view_type{data_, n_}; }
+    size_t size() const { return n_; }
+    size_t size_bytes() const { return bytes_; }
+
+    // Copy the raw storage to the host; wrap the result with host_view() to read fields
+    std::vector<std::byte> download() {
+        std::vector<std::byte> host(bytes_);
+        q_.memcpy(host.data(), data_, bytes_).wait();
+        return host;
+    }
+
+    view_type host_view(std::vector<std::byte>& host) const { return view_type{host.data(), n_}; }
+
+private:
+    sycl::queue& q_;
+    size_t n_;
+    size_t bytes_;
+    std::byte* data_;
+};
+
+template <class... Fields>
+using soa_vector = record_vector<layout::soa, Fields...>;
+
+template <class... Fields>
+using aos_vector = record_vector<layout::aos, Fields...>;
+
+// Particle benchmark
+//
+// Ten fields per particle (40 bytes). The update kernel uses seven of them; the drift kernel
+// uses one. The unused fields are what AoS pays for and SoA does not.
+enum field : size_t { PX, PY, PZ, VX, VY, VZ, MASS, CHARGE, ID, FLAGS };
+
+template <layout L>
+using particles = record_vector<L, float, float, float, float, float, float, float, float,
+                                std::uint32_t, std::uint32_t>;
+
+constexpr float DT = 0.01f;
+constexpr float K_SPRING = 0.5f;
+
+template <layout L>
+void init(sycl::queue& q, particles<L>& p) {
+    auto v = p.view();
+    q.parallel_for(sycl::range<1>{p.size()}, [=](sycl::id<1> idx) {
+        size_t i = idx[0];
+        float f = static_cast<float>(i % 1000) * 0.001f;
+        v.template get<PX>(i) = f;
+        v.template get<PY>(i) = -f;
+        v.template get<PZ>(i) = 2.0f * f;
+        v.template get<VX>(i) = 0.0f;
+        v.template get<VY>(i) = 1.0f;
+        v.template get<VZ>(i) = 0.0f;
+        v.template get<MASS>(i) = 1.0f + f;
+        v.template get<CHARGE>(i) = 1.0f;
+        v.template get<ID>(i) = static_cast<std::uint32_t>(i);
+        v.template get<FLAGS>(i) = 0u;
+    }).wait();
+}
+
+// Spring force towards the origin, semi-implicit Euler. Touches 7 of 10 fields.
+template <layout L>
+sycl::event update(sycl::queue& q, particles<L>& p) {
+    auto v = p.view();
+    return q.parallel_for(sycl::range<1>{p.size()}, [=](sycl::id<1> idx) {
+        size_t i = idx[0];
+        float inv_m = 1.0f / v.template get<MASS>(i);
+        float vx = v.template get<VX>(i) - DT * K_SPRING * v.template get<PX>(i) * inv_m;
+        float vy = v.template get<VY>(i) - DT * K_SPRING * v.template get<PY>(i) * inv_m;
+        float vz = v.template get<VZ>(i) - DT * K_SPRING * v.template get<PZ>(i) * inv_m;
+        v.template get<VX>(i) = vx;
+        v.template get<VY>(i) = vy;
+        v.template get<VZ>(i) = vz;
+        v.template get<PX>(i) += DT * vx;
+        v.template get<PY>(i) += DT * vy;
+        v.template get<PZ>(i) += DT * vz;
+    });
+}
+
+// Touches 1 of 10 fields.
+template <layout L>
+sycl::event drift(sycl::queue& q, particles<L>& p) {
+    auto v = p.view();
+    return q.parallel_for(sycl::range<1>{p.size()}, [=](sycl::id<1> idx) {
+        v.template get<PX>(idx[0]) += DT;
+    });
+}
+
+struct result {
+    double update_ms;
+    double drift_ms;
+    std::vector<float> sample; // PX, VY of a few particles, for cross-checking layouts
+};
+
+template <layout L>
+result run(sycl::queue& q, size_t n, int steps) {
+    particles<L> p{q, n};
+    init(q, p);
+    update(q, p).wait(); // warm-up / JIT
+    drift(q, p).wait();
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (int s = 0; s < steps; ++s) {
+        update(q, p);
+    }
+    q.wait();
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (int s = 0; s < steps; ++s) {
+        drift(q, p);
+    }
+    q.wait();
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    result r;
+    r.update_ms = std::chrono::duration<double, std::milli>(t1 - t0).count() / steps;
+    r.drift_ms = std::chrono::duration<double, std::milli>(t2 - t1).count() / steps;
+
+    auto host = p.download();
+    auto hv = p.host_view(host);
+    for (size_t i : {size_t{0}, size_t{1}, n / 2, n - 1}) {
+        r.sample.push_back(hv.template get<PX>(i));
+        r.sample.push_back(hv.template get<VY>(i));
+    }
+    return r;
+}
+
+int main(int argc, char* argv[]) {
+    size_t N = 8 * 1024 * 1024;
+    if (argc > 1) {
+        try {
+            N = std::stoull(argv[1]);
+        } catch (const std::exception& e) {
+            std::cerr << "Error parsing N: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    const int STEPS = 20;
+
+    sycl::queue q{sycl::default_selector_v, sycl::property_list{sycl::property::queue::in_order{}}};
+    std::cout << "Using device: " << q.get_device().get_info<sycl::info::device::name>() << std::endl;
+    std::cout << N << " particles, " << particles<layout::aos>::info::record_size()
+              << " bytes per record, " << STEPS << " steps" << std::endl;
+
+    result soa = run<layout::soa>(q, N, STEPS);
+    result aos = run<layout::aos>(q, N, STEPS);
+
+    // Useful bytes: update reads 7 fields and writes 6, drift reads and writes 1
+    const double update_bytes = static_cast<double>(N) * (7 + 6) * sizeof(float);
+    const double drift_bytes = static_cast<double>(N) * 2 * sizeof(float);
+
+    std::cout << std::left << std::setw(8) << "Layout"
+              << std::right << std::setw(14) << "update ms"
+              << std::setw(16) << "update GB/s"
+              << std::setw(14) << "drift ms"
+              << std::setw(16) << "drift GB/s" << std::endl;
+    for (const auto& [name, r] : {std::pair<const char*, const result&>{"SoA", soa},
+                                  std::pair<const char*, const result&>{"AoS", aos}}) {
+        std::cout << std::left << std::setw(8) << name
+                  << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(14) << r.update_ms
+                  << std::setw(16) << update_bytes / (r.update_ms / 1000.0) / 1e9
+                  << std::setw(14) << r.drift_ms
+                  << std::setw(16) << drift_bytes / (r.drift_ms / 1000.0) / 1e9 << std::endl;
+    }
+    std::cout << "SoA speedup: update " << aos.update_ms / soa.update_ms << "x, drift "
+              << aos.drift_ms / soa.drift_ms << "x" << std::endl;
+
+    // Both layouts run the same arithmetic, so the results must match exactly
+    bool ok = soa.sample == aos.sample;
+    std::cout << "SoA/AoS particles: " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}